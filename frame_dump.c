@@ -0,0 +1,233 @@
+// Sample consumer for mandelbrot's shared-memory frame export (-x)
+// Maps the frame ring read-only and writes each new frame to disk as a PPM,
+// with the view in a header comment, and optionally the iteration counts
+// as a 16-bit PGM.
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include "frame_export.h"
+
+#define POLL_INTERVAL_MS 10   // How often to look for a new frame
+
+volatile sig_atomic_t quit_flag = 0;
+
+void signal_handler(int sig) {
+    (void)sig;
+    quit_flag = 1;
+}
+
+void print_usage(const char* prog_name) {
+    printf("Usage: %s [options] <name>\n", prog_name);
+    printf("Dump frames published by 'mandelbrot -x <name>' to disk.\n");
+    printf("Options:\n");
+    printf("  -o, --output <dir>     Directory for frame files (default: .)\n");
+    printf("  -c, --count <n>        Exit after writing <n> frames (default: run until Ctrl+C)\n");
+    printf("  -i, --iterations       Also write iteration counts as 16-bit PGM\n");
+    printf("  -h, --help             Show this help message\n");
+}
+
+// Expand a framebuffer colour field to 8 bits
+uint8_t field_to_8bit(uint32_t pixel, uint32_t offset, uint32_t length) {
+    if (length == 0) {
+        return 0;
+    }
+    uint32_t max = (1u << length) - 1;
+    return (uint8_t)(((pixel >> offset) & max) * 255 / max);
+}
+
+// Write one slot's frame. The slot is read in place, so the caller checks
+// afterwards that the renderer did not overwrite it while we were writing.
+bool write_frame(const frame_export_header_t* header, const char* slot_base,
+                 uint64_t sequence, const char* dir, bool write_iterations) {
+    const frame_export_slot_t* slot = (const frame_export_slot_t*)slot_base;
+    const uint8_t* pixels = (const uint8_t*)slot_base + header->pixels_offset;
+    int bytes_per_pixel = header->bits_per_pixel / 8;
+    char path[4096];
+
+    snprintf(path, sizeof(path), "%s/frame_%06llu.ppm", dir, (unsigned long long)sequence);
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        fprintf(stderr, "Error: Could not write %s: %s\n", path, strerror(errno));
+        return false;
+    }
+
+    fprintf(file, "P6\n# %s scaling=%.10f x_offset=%.10f y_offset=%.10f colour_offset=%d",
+            slot->formula_name, slot->scaling, slot->x_offset, slot->y_offset, slot->colour_offset);
+    if (strcmp(slot->formula_name, "julia") == 0) {
+        fprintf(file, " julia_re=%.10f julia_im=%.10f", slot->julia_re, slot->julia_im);
+    }
+    fprintf(file, " render_ms=%u\n%u %u\n255\n", slot->render_ms, header->width, header->height);
+
+    uint8_t* rgb = malloc((size_t)header->width * 3);
+    if (!rgb) {
+        fclose(file);
+        return false;
+    }
+    for (uint32_t j = 0; j < header->height; j++) {
+        const uint8_t* row = pixels + (size_t)j * header->line_length;
+        for (uint32_t i = 0; i < header->width; i++) {
+            uint32_t pixel = 0;
+            memcpy(&pixel, row + i * bytes_per_pixel, bytes_per_pixel);  // Little-endian framebuffer
+            rgb[i * 3] = field_to_8bit(pixel, header->red_offset, header->red_length);
+            rgb[i * 3 + 1] = field_to_8bit(pixel, header->green_offset, header->green_length);
+            rgb[i * 3 + 2] = field_to_8bit(pixel, header->blue_offset, header->blue_length);
+        }
+        fwrite(rgb, 3, header->width, file);
+    }
+    free(rgb);
+    fclose(file);
+
+    if (write_iterations) {
+        const uint16_t* iters = (const uint16_t*)(slot_base + header->iterations_offset);
+        snprintf(path, sizeof(path), "%s/frame_%06llu_iter.pgm", dir, (unsigned long long)sequence);
+        file = fopen(path, "wb");
+        if (!file) {
+            fprintf(stderr, "Error: Could not write %s: %s\n", path, strerror(errno));
+            return false;
+        }
+        fprintf(file, "P5\n%u %u\n%u\n", header->width, header->height, header->max_iterations);
+        for (size_t p = 0; p < (size_t)header->width * header->height; p++) {
+            uint8_t be[2] = { iters[p] >> 8, iters[p] & 0xFF };  // PGM samples are big-endian
+            fwrite(be, 1, 2, file);
+        }
+        fclose(file);
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    const char* name = NULL;
+    const char* dir = ".";
+    long count = 0;
+    bool write_iterations = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "--output") == 0) {
+            if (i + 1 < argc) {
+                dir = argv[++i];
+            } else {
+                fprintf(stderr, "Error: -o/--output requires a directory\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--count") == 0) {
+            if (i + 1 < argc && sscanf(argv[i + 1], "%ld", &count) == 1 && count > 0) {
+                i++;
+            } else {
+                fprintf(stderr, "Error: -c/--count requires a positive number\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-i") == 0 || strcmp(argv[i], "--iterations") == 0) {
+            write_iterations = true;
+        } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else if (argv[i][0] != '-' && !name) {
+            name = argv[i];
+        } else {
+            fprintf(stderr, "Error: Unknown option '%s'\n", argv[i]);
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (!name) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    signal(SIGINT, signal_handler);
+    signal(SIGTERM, signal_handler);
+
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        fprintf(stderr, "Error: Could not open frame export %s: %s\n", name, strerror(errno));
+        return 1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(frame_export_header_t)) {
+        fprintf(stderr, "Error: Frame export %s is empty\n", name);
+        close(fd);
+        return 1;
+    }
+    const char* map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror("Error mapping frame export");
+        return 1;
+    }
+
+    const frame_export_header_t* header = (const frame_export_header_t*)map;
+    if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != FRAME_EXPORT_MAGIC ||
+        header->version != FRAME_EXPORT_VERSION ||
+        header->slots_offset + header->slot_size * header->slot_count > (uint64_t)st.st_size) {
+        fprintf(stderr, "Error: %s is not a mandelbrot frame export\n", name);
+        munmap((void*)map, st.st_size);
+        return 1;
+    }
+
+    printf("Dumping %ux%u frames from %s to %s\n", header->width, header->height, name, dir);
+
+    // Start with the newest frame already published, then follow new ones
+    uint64_t next = __atomic_load_n(&header->latest, __ATOMIC_ACQUIRE);
+    if (next == 0) {
+        next = 1;
+    }
+    long written = 0;
+    long dropped = 0;
+
+    while (!quit_flag && (count == 0 || written < count)) {
+        uint64_t latest = __atomic_load_n(&header->latest, __ATOMIC_ACQUIRE);
+        if (latest < next) {
+            usleep(POLL_INTERVAL_MS * 1000);
+            continue;
+        }
+
+        // Frames older than the ring have already been overwritten
+        if (latest - next >= header->slot_count) {
+            dropped += latest - next - header->slot_count + 1;
+            next = latest - header->slot_count + 1;
+        }
+
+        const char* slot_base = map + header->slots_offset +
+                                ((next - 1) % header->slot_count) * header->slot_size;
+        const frame_export_slot_t* slot = (const frame_export_slot_t*)slot_base;
+
+        if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) == next) {
+            bool ok = write_frame(header, slot_base, next, dir, write_iterations);
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&slot->sequence, __ATOMIC_RELAXED) != next) {
+                // Overwritten while we were writing it; the files are torn
+                char path[4096];
+                snprintf(path, sizeof(path), "%s/frame_%06llu.ppm", dir, (unsigned long long)next);
+                unlink(path);
+                snprintf(path, sizeof(path), "%s/frame_%06llu_iter.pgm", dir, (unsigned long long)next);
+                unlink(path);
+                printf("Frame %llu overwritten while dumping, dropped\n", (unsigned long long)next);
+                dropped++;
+            } else if (ok) {
+                printf("Wrote frame %llu\n", (unsigned long long)next);
+                written++;
+            } else {
+                break;
+            }
+        } else {
+            dropped++;
+        }
+        next++;
+    }
+
+    printf("Wrote %ld frames, dropped %ld\n", written, dropped);
+    munmap((void*)map, st.st_size);
+    return 0;
+}
@@ -0,0 +1,59 @@
+// Shared-memory frame export layout, shared by mandelbrot (-x) and frame_dump
+//
+// The renderer publishes every completed frame into a ring of slots in a
+// POSIX shared memory object (/dev/shm/<name>). Frame n (counting from 1)
+// lives in slot (n - 1) % slot_count. Readers map the object read-only and
+// treat each slot's sequence as a seqlock: load it, use the slot in place,
+// load it again and drop the frame unless both loads equal n. A slot's
+// sequence is 0 while the renderer is rewriting it.
+
+#ifndef FRAME_EXPORT_H
+#define FRAME_EXPORT_H
+
+#include <stdint.h>
+
+#define FRAME_EXPORT_MAGIC 0x4D465831u   // "MFX1"
+#define FRAME_EXPORT_VERSION 1
+#define FRAME_EXPORT_SLOTS 4             // Frames kept before the oldest is overwritten
+#define FRAME_EXPORT_ALIGN 4096          // Header and slot data start on page boundaries
+
+// At offset 0 of the shared memory object
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slot_count;
+    uint32_t width;
+    uint32_t height;
+    uint32_t bits_per_pixel;      // Framebuffer format of the pixel data
+    uint32_t line_length;         // Bytes per pixel row
+    uint32_t red_offset;          // Colour bitfields as in fb_var_screeninfo
+    uint32_t red_length;
+    uint32_t green_offset;
+    uint32_t green_length;
+    uint32_t blue_offset;
+    uint32_t blue_length;
+    uint32_t max_iterations;      // Iteration count of points inside the set
+    uint64_t slots_offset;        // Offset of slot 0 from the start of the object
+    uint64_t slot_size;           // Bytes from one slot to the next
+    uint64_t pixels_offset;       // Offsets of the frame data within a slot
+    uint64_t iterations_offset;   // width * height uint16 iteration counts
+    uint64_t latest;              // Sequence of the newest complete frame, 0 before the first
+} frame_export_header_t;
+
+// At the start of each slot, followed by the pixel and iteration data
+typedef struct {
+    uint64_t sequence;            // Frame number, 0 while being written
+    int64_t timestamp_us;         // CLOCK_MONOTONIC time the frame completed
+    uint32_t render_ms;
+    int32_t formula;
+    char formula_name[16];
+    int32_t colour_offset;
+    uint32_t reserved;
+    double scaling;
+    double x_offset;
+    double y_offset;
+    double julia_re;
+    double julia_im;
+} frame_export_slot_t;
+
+#endif
@@ -14,4 +14,5 @@ SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
 # Launch mandelbrot from script directory
 cd "$SCRIPT_DIR"
 echo "Starting mandelbrot..."
-./mandelbrot "$@"
+# MANDELBROT_OPTS (e.g. from mandelbrot.service) is split into separate options
+./mandelbrot $MANDELBROT_OPTS "$@"
@@ -1,10 +1,11 @@
 // direct framebuffer rendering version
 
-#define _DEFAULT_SOURCE
+#define _GNU_SOURCE  // pthread_setaffinity_np, CPU_SET
 #include <stdio.h>
 #include <stdlib.h>
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/ioctl.h>
 #include <linux/fb.h>
 #include <linux/input.h>
@@ -17,9 +18,21 @@
 #include <pthread.h>
 #include <errno.h>
 #include <gpiod.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <poll.h>
+#include <endian.h>
+#include "frame_export.h"
 
 #define MAXI 360
 #define COLOUR_SCALE 18
+#define NUM_RENDER_THREADS 4
 
 // Idle animation configuration
 #define IDLE_TIMEOUT_MS 10000      // 10 seconds of inactivity before animation starts
@@ -28,11 +41,98 @@
 #define SNAP_DELTA_OFFSET 0.001    // Snap when offset difference < this
 #define INTERPOLATION_SPEED 0.05   // How much to move toward target each step (0.0-1.0)
 
+// Scheduling and power configuration
+#define TOUCH_POLL_TIMEOUT_MS 200        // Longest touch wait before rechecking quit_flag
+#define PARK_MAX_WAIT_MS 1000            // Longest low-power park before rechecking quit_flag
+
+// Distributed tile rendering configuration
+#define TILE_SIZE 64                     // Tile edge in pixels handed to a worker
+#define TILE_MAX_PIXELS (256 * 256)      // Largest tile a worker will accept
+#define TILE_PROTO_MAGIC 0x4D414E32u     // "MAN2"
+#define TILE_JOB_BYTES 72                // Serialised tile_job_t size
+#define TILE_REPLY_BYTES 20              // Serialised reply header size
+#define TILE_ENCODING_RAW 0              // Payload is uint16 iteration counts
+#define TILE_ENCODING_RLE 1              // Payload is (run, value) uint16 pairs
+#define TILE_TIMEOUT_MS 10000            // Give up on a tile after this long
+#define TILE_STRAGGLER_MS 500            // Hand an in-flight tile to an idle thread after this long
+#define TILE_POLL_MS 100                 // Recheck cancellation this often while awaiting a reply
+#define WORKER_CONNECT_TIMEOUT_MS 1000   // Connect timeout per worker connection
+#define WORKER_CONNECTIONS 4             // Connections per worker (one per Pi core)
+#define WORKER_MAX_RETRIES 3             // Consecutive failures before backing off
+#define WORKER_RETRY_DELAY_MS 200        // Pause between reconnect attempts
+#define WORKER_BACKOFF_MS 30000          // Skip an unreachable worker for this long
+#define MAX_REMOTE_WORKERS 16
+#define REFERENCE_WIDTH 320              // Views are framed for the 320x240 TFT
+#define REFERENCE_HEIGHT 240
+
+// Adaptive anti-aliasing configuration
+#define AA_SAMPLES 4                     // Jittered samples per refined pixel (2x2 strata)
+
+// Julia set configuration
+#define JULIA_HOLD_MS 800                // Touch held this long picks a Julia constant
+#define JULIA_DEFAULT_RE -0.8            // Julia constant when started with -f julia
+#define JULIA_DEFAULT_IM 0.156
+#define JULIA_SCALING 0.01125            // Initial Julia view: origin centred, 3.6 wide
+#define JULIA_X_OFFSET 1.8
+#define JULIA_Y_OFFSET 1.35
+
+// Fractal formulas. Each formula is an INIT/STEP pair that the kernel macros
+// below expand into their own loops, so the formula is chosen once per frame
+// or tile and the inner loop never branches on it.
+//   INIT sets z = (x, y) and c = (cu, cv) for the pixel at (u, v)
+//   STEP advances z, given x_sq = x * x and y_sq = y * y
+//   SKIP is true where (u, v) is known to be in the set, short-circuiting
+//        the loop; SKIP_NONE compiles away
+// Bodies must not contain top-level commas as they are passed between macros.
+#define INIT_MANDELBROT x = u; y = v; cu = u; cv = v;
+#define INIT_JULIA x = u; y = v; cu = jr; cv = ji;
+#define STEP_Z2 y = 2 * x * y + cv; x = x_sq - y_sq + cu;
+#define STEP_Z3 { double t = x * (x_sq - 3 * y_sq) + cu; y = y * (3 * x_sq - y_sq) + cv; x = t; }
+#define STEP_Z4 { double a = x_sq - y_sq; double b = 2 * x * y; x = a * a - b * b + cu; y = 2 * a * b + cv; }
+#define STEP_BURNING_SHIP y = fabs(2 * x * y) + cv; x = x_sq - y_sq + cu;
+#define SKIP_NONE 0
+#define SKIP_CARDIOID_BULB \
+    ((((u - 0.25) * (u - 0.25) + v * v) * (((u - 0.25) * (u - 0.25) + v * v) + (u - 0.25)) < 0.25 * v * v) || \
+     ((u + 1) * (u + 1) + v * v < 0.0625))
+
+// X(ID, name, INIT, STEP, SKIP) - name is used on the command line and in saved_view.txt
+#define FORMULA_LIST(X) \
+    X(MANDELBROT, mandelbrot, INIT_MANDELBROT, STEP_Z2, SKIP_CARDIOID_BULB) \
+    X(JULIA, julia, INIT_JULIA, STEP_Z2, SKIP_NONE) \
+    X(MULTIBROT3, multibrot3, INIT_MANDELBROT, STEP_Z3, SKIP_NONE) \
+    X(MULTIBROT4, multibrot4, INIT_MANDELBROT, STEP_Z4, SKIP_NONE) \
+    X(BURNING_SHIP, burningship, INIT_MANDELBROT, STEP_BURNING_SHIP, SKIP_NONE)
+
+#define FORMULA_ENUM(ID, name, INIT, STEP, SKIP) FORMULA_##ID,
+typedef enum { FORMULA_LIST(FORMULA_ENUM) NUM_FORMULAS } formula_t;
+
+// Escape-time loop shared by every kernel; expects u, v, jr, ji in scope and
+// stores the iteration count in n_out. LIMIT is the literal MAXI in frame
+// kernels so each formula x limit pair compiles to its own loop.
+#define ITERATE(INIT, STEP, LIMIT, n_out) { \
+    double x, y, cu, cv; \
+    double x_sq = 0; \
+    double y_sq = 0; \
+    int count = 0; \
+    INIT \
+    while (x_sq + y_sq < 4.0 && count < (LIMIT)) { \
+        x_sq = x * x; \
+        y_sq = y * y; \
+        STEP \
+        count++; \
+    } \
+    n_out = count; \
+}
+
 // Mandelbrot parameters (now mutable for zoom/pan)
 double scaling = 0.013;
 double x_offset = 2.6;
 double y_offset = 1.6;
 int colour_offset = 0;  // Color cycle offset (0 to COLOUR_SCALE-1)
+int formula = FORMULA_MANDELBROT;  // Fractal formula for the next frame
+double julia_re = JULIA_DEFAULT_RE;  // Julia constant c (used by FORMULA_JULIA)
+double julia_im = JULIA_DEFAULT_IM;
+int initial_formula = FORMULA_MANDELBROT;  // Formula restored by the reset button
 
 // Runtime dimensions (determined from framebuffer)
 int width = 0;
@@ -55,6 +155,9 @@ typedef struct {
     double x_offset;
     double y_offset;
     int colour_offset;
+    int formula;
+    double julia_re;
+    double julia_im;
 } saved_view_t;
 
 // Global variables for cleanup and shared state
@@ -68,17 +171,50 @@ volatile sig_atomic_t redraw_flag = 0;
 const char* fb_device = "/dev/fb1";  // Default to TFT display
 const char* touch_device = "/dev/input/by-path/platform-3f204000.spi-cs-1-platform-stmpe-ts-event";  // Stable path to stmpe-ts touchscreen
 pthread_mutex_t param_mutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_mutex_t redraw_mutex = PTHREAD_MUTEX_INITIALIZER;  // Pairs with redraw_cond
+pthread_cond_t redraw_cond = PTHREAD_COND_INITIALIZER;     // Wakes a parked main loop
+
+// Scheduling isolation between render workers and input/presentation
+cpu_set_t render_cpu_set;        // CPUs render threads may run on
+bool render_cpus_set = false;    // False leaves render threads unpinned
+int input_cpu = -1;              // Core reserved for input and presentation, -1 for none
+int input_fifo_priority = 0;     // SCHED_FIFO priority for input/presentation, 0 for none
+int render_nice = 0;             // Nice level for render threads
+bool low_power = false;          // Park the main loop until a frame is pending
 
 // Saved views array
 #define MAX_SAVED_VIEWS 1000
 saved_view_t saved_views[MAX_SAVED_VIEWS];
 int num_saved_views = 0;
 
+// Remote tile worker connection (one entry per connection slot)
+typedef struct {
+    char host[64];
+    char port[8];
+    int fd;            // Persistent connection, -1 when disconnected
+    int failures;      // Consecutive lost tiles, kept across frames
+    long retry_after;  // Skip this slot until this time (ms) after repeated failures
+} remote_worker_t;
+
+remote_worker_t remote_workers[MAX_REMOTE_WORKERS * WORKER_CONNECTIONS];
+int num_remote_workers = 0;      // Number of connection slots in use
+uint16_t* frame_iterations = NULL;  // Per-pixel iteration counts for the current frame
+int antialias_threshold = -1;       // Refine pixels whose neighbours differ by more; -1 disables
+
+// Shared-memory frame export (see frame_export.h)
+frame_export_header_t* frame_export = NULL;
+size_t frame_export_size = 0;
+const char* frame_export_name = NULL;
+char* frame_pixels = NULL;  // RAM copy of the frame, laid out as fbp, that exports are taken from
+
 // Idle animation state
 volatile sig_atomic_t last_interaction_time = 0;
 volatile sig_atomic_t animating = 0;
 int current_target_view = 0;
 
+// View to return to when leaving a Julia set picked by long press
+saved_view_t pre_julia_view = { 0.013, 2.6, 1.6, 0, FORMULA_MANDELBROT, 0, 0 };
+
 // Signal handler for Ctrl+C
 void signal_handler(int sig __attribute__((unused))) {
     quit_flag = 1;
@@ -111,23 +247,95 @@ void hsb_to_rgb(float h, float s, float b, uint8_t* r, uint8_t* g, uint8_t* bl)
     *bl = (uint8_t)((b_prime + m) * 255);
 }
 
-// Calculate Mandelbrot iteration count for a given point
-int mandelbrot_iterations(double u, double v) {
-    double x = u;
-    double y = v;
-    int n = 0;
-    double x_sq = 0;
-    double y_sq = 0;
-    
-    while (x_sq + y_sq < 4.0 && n < MAXI) {
-        x_sq = x * x;
-        y_sq = y * y;
-        y = 2 * x * y + v;
-        x = x_sq - y_sq + u;
-        n++;
+// Per-point iteration count for each formula, up to max_iter (used where a
+// call per point is cheap next to the iterations, e.g. anti-aliasing samples).
+// Callers apply the SKIP test first through formula_skips.
+#define DEFINE_ITERATE_POINT(ID, name, INIT, STEP, SKIP) \
+int iterate_##name(double u, double v, double jr __attribute__((unused)), \
+                   double ji __attribute__((unused)), int max_iter) { \
+    int n; \
+    ITERATE(INIT, STEP, max_iter, n) \
+    return n; \
+}
+FORMULA_LIST(DEFINE_ITERATE_POINT)
+
+// Per-point SKIP test for each formula. A short-circuited point is drawn as
+// MAXI but costs no iterations, and is counted that way everywhere.
+#define DEFINE_SKIP_POINT(ID, name, INIT, STEP, SKIP) \
+bool skips_##name(double u __attribute__((unused)), double v __attribute__((unused))) { \
+    return SKIP; \
+}
+FORMULA_LIST(DEFINE_SKIP_POINT)
+
+typedef int (*iterate_point_fn)(double u, double v, double jr, double ji, int max_iter);
+typedef bool (*skip_point_fn)(double u, double v);
+
+#define ITERATE_POINT_ENTRY(ID, name, INIT, STEP, SKIP) iterate_##name,
+iterate_point_fn formula_iterate[NUM_FORMULAS] = { FORMULA_LIST(ITERATE_POINT_ENTRY) };
+
+#define SKIP_POINT_ENTRY(ID, name, INIT, STEP, SKIP) skips_##name,
+skip_point_fn formula_skips[NUM_FORMULAS] = { FORMULA_LIST(SKIP_POINT_ENTRY) };
+
+#define FORMULA_NAME_ENTRY(ID, name, INIT, STEP, SKIP) #name,
+const char* formula_names[NUM_FORMULAS] = { FORMULA_LIST(FORMULA_NAME_ENTRY) };
+
+// Look up a formula by name, returning -1 if unknown
+int formula_from_name(const char* name) {
+    for (int f = 0; f < NUM_FORMULAS; f++) {
+        if (strcmp(name, formula_names[f]) == 0) {
+            return f;
+        }
+    }
+    return -1;
+}
+
+// Frame the starting view for a formula (caller holds param_mutex)
+void set_initial_view(int new_formula) {
+    formula = new_formula;
+    if (formula == FORMULA_JULIA) {
+        scaling = JULIA_SCALING;
+        x_offset = JULIA_X_OFFSET;
+        y_offset = JULIA_Y_OFFSET;
+    } else {
+        scaling = 0.013;
+        x_offset = 2.6;
+        y_offset = 1.6;
+    }
+}
+
+// Map an iteration count to its palette colour (black for points in the set)
+void iteration_colour(int n, int colour_offset, uint8_t* r, uint8_t* g, uint8_t* b) {
+    if (n >= MAXI) {
+        *r = 0; *g = 0; *b = 0;
+        return;
+    }
+    float hue = fmod((n * 360.0 * COLOUR_SCALE) / MAXI + colour_offset * 360.0 / COLOUR_SCALE, 360.0);
+    hsb_to_rgb(hue, 1.0, 1.0, r, g, b);
+}
+
+// Palette for one colour_offset indexed by iteration count, so colouring a
+// whole frame costs one lookup per pixel instead of an HSB conversion
+void build_palette(uint8_t palette[MAXI + 1][3], int colour_offset) {
+    for (int n = 0; n <= MAXI; n++) {
+        iteration_colour(n, colour_offset, &palette[n][0], &palette[n][1], &palette[n][2]);
+    }
+}
+
+// The same palette packed into framebuffer bytes, as set_pixel_fb stores them
+void build_fb_palette(uint8_t fb_palette[MAXI + 1][4], struct fb_var_screeninfo* vinfo,
+                      int colour_offset) {
+    uint8_t palette[MAXI + 1][3];
+    build_palette(palette, colour_offset);
+    for (int n = 0; n <= MAXI; n++) {
+        uint8_t r = palette[n][0], g = palette[n][1], b = palette[n][2];
+        uint8_t* p = fb_palette[n];
+        if (vinfo->bits_per_pixel == 16) {
+            uint16_t color = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+            memcpy(p, &color, sizeof(color));
+        } else {
+            p[0] = b; p[1] = g; p[2] = r; p[3] = 255;
+        }
     }
-    
-    return n;
 }
 
 // Set pixel directly in framebuffer
@@ -164,12 +372,202 @@ long get_time_ms() {
     return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
 }
 
+// Get current time in microseconds (64-bit so it does not wrap on 32-bit Pis)
+int64_t get_time_us() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
 // Reset idle timer (call on any user interaction)
 void reset_idle_timer() {
     last_interaction_time = get_time_ms();
     animating = 0;
 }
 
+// True once the frame being rendered is stale: quitting, or input has asked
+// for another redraw, in which case the partial frame is abandoned. Band
+// kernels and the anti-aliasing pass check it once per row, tiled frames
+// before each tile and while awaiting a worker's reply. The idle animation
+// only sets redraw_flag between frames, so it never abandons one.
+bool frame_cancelled() {
+    return quit_flag || redraw_flag;
+}
+
+// Telemetry. Counters are updated with relaxed atomics from the render path
+// and read by the metrics exporter without taking any lock.
+#define STAT_ADD(counter, value) __atomic_fetch_add(&(counter), (value), __ATOMIC_RELAXED)
+#define STAT_LOAD(counter) __atomic_load_n(&(counter), __ATOMIC_RELAXED)
+
+// Histogram bucket upper bounds in microseconds (plus an implicit +Inf)
+#define HISTOGRAM_BUCKETS 13
+const int64_t histogram_bounds_us[HISTOGRAM_BUCKETS] = {
+    1000, 2500, 5000, 10000, 25000, 50000, 100000,
+    250000, 500000, 1000000, 2500000, 5000000, 10000000
+};
+
+typedef struct {
+    uint64_t buckets[HISTOGRAM_BUCKETS + 1];  // Non-cumulative; last is +Inf
+    uint64_t count;
+    uint64_t sum_us;
+} histogram_t;
+
+typedef struct {
+    histogram_t frame_time;          // Completed frames, start to last pixel
+    histogram_t present_time;        // Writing tile-assembled frames to fbp
+    histogram_t input_latency;       // Input event to completed frame
+    uint64_t frames_rendered;
+    uint64_t frames_abandoned;       // Cut short by new input (or exit)
+    uint64_t iterations;
+    uint64_t pixels_rendered;
+    uint64_t pixels_short_circuited;
+    uint64_t aa_pixels_refined;
+    uint64_t fb_bytes_written;
+    uint64_t thread_busy_us[NUM_RENDER_THREADS];
+    uint64_t thread_idle_us[NUM_RENDER_THREADS];
+} render_stats_t;
+
+render_stats_t stats;
+int64_t input_pending_us = 0;  // Time of the oldest input no frame has claimed yet, 0 if none
+
+void histogram_observe(histogram_t* h, int64_t us) {
+    int bucket = 0;
+    while (bucket < HISTOGRAM_BUCKETS && us > histogram_bounds_us[bucket]) {
+        bucket++;
+    }
+    STAT_ADD(h->buckets[bucket], 1);
+    STAT_ADD(h->count, 1);
+    STAT_ADD(h->sum_us, us > 0 ? (uint64_t)us : 0);
+}
+
+// Request a redraw on behalf of user input. The oldest pending input is
+// kept so input-to-render latency covers any frames abandoned meanwhile.
+void request_input_redraw() {
+    int64_t expected = 0;
+    __atomic_compare_exchange_n(&input_pending_us, &expected, get_time_us(), false,
+                                __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+    pthread_mutex_lock(&redraw_mutex);
+    redraw_flag = 1;
+    pthread_cond_signal(&redraw_cond);
+    pthread_mutex_unlock(&redraw_mutex);
+}
+
+// Low-power mode: block until input requests a redraw or deadline_ms (the
+// idle animation start, 0 for none) passes, instead of polling every
+// ANIMATION_STEP_MS. Render threads only exist while a frame is pending, so
+// with the main loop parked nothing on the render side wakes up.
+void wait_for_redraw(long deadline_ms) {
+    pthread_mutex_lock(&redraw_mutex);
+    while (!redraw_flag && !quit_flag) {
+        long now = get_time_ms();
+        if (deadline_ms > 0 && now >= deadline_ms) {
+            break;
+        }
+        long wait_ms = PARK_MAX_WAIT_MS;
+        if (deadline_ms > 0 && deadline_ms - now < wait_ms) {
+            wait_ms = deadline_ms - now;
+        }
+
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += wait_ms / 1000;
+        deadline.tv_nsec += (wait_ms % 1000) * 1000000;
+        if (deadline.tv_nsec >= 1000000000) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
+        }
+        pthread_cond_timedwait(&redraw_cond, &redraw_mutex, &deadline);
+    }
+    pthread_mutex_unlock(&redraw_mutex);
+}
+
+// Parse a CPU list such as "1,2,3" or "1-3" into a cpu_set_t
+bool parse_cpu_list(const char* list, cpu_set_t* set) {
+    char buf[256];
+    snprintf(buf, sizeof(buf), "%s", list);
+    CPU_ZERO(set);
+
+    for (char* entry = strtok(buf, ","); entry; entry = strtok(NULL, ",")) {
+        int first, last;
+        if (sscanf(entry, "%d-%d", &first, &last) != 2) {
+            if (sscanf(entry, "%d", &first) != 1) {
+                return false;
+            }
+            last = first;
+        }
+        if (first < 0 || last < first || last >= CPU_SETSIZE) {
+            return false;
+        }
+        for (int cpu = first; cpu <= last; cpu++) {
+            CPU_SET(cpu, set);
+        }
+    }
+    return CPU_COUNT(set) > 0;
+}
+
+// Apply the input/presentation policy to the calling (main) thread before it
+// starts the input threads, which inherit its CPU and scheduling class
+void apply_input_thread_policy() {
+    // Without an explicit render set, keep render threads off the input core.
+    // Read the process mask before this thread is pinned to the input core.
+    if (input_cpu >= 0 && !render_cpus_set) {
+        sched_getaffinity(0, sizeof(render_cpu_set), &render_cpu_set);
+        CPU_CLR(input_cpu, &render_cpu_set);
+        render_cpus_set = CPU_COUNT(&render_cpu_set) > 0;
+        if (!render_cpus_set) {
+            fprintf(stderr, "Warning: No CPU left for render threads besides input CPU %d\n", input_cpu);
+        }
+    }
+
+    if (input_cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(input_cpu, &set);
+        int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (err != 0) {
+            fprintf(stderr, "Warning: Could not pin input threads to CPU %d: %s\n", input_cpu, strerror(err));
+        } else {
+            printf("Input and presentation pinned to CPU %d\n", input_cpu);
+        }
+    }
+
+    if (input_fifo_priority > 0) {
+        struct sched_param param = { .sched_priority = input_fifo_priority };
+        int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (err != 0) {
+            fprintf(stderr, "Warning: Could not set SCHED_FIFO %d for input threads: %s "
+                            "(needs CAP_SYS_NICE or LimitRTPRIO)\n", input_fifo_priority, strerror(err));
+            input_fifo_priority = 0;
+        } else {
+            printf("Input and presentation running SCHED_FIFO priority %d\n", input_fifo_priority);
+        }
+    }
+}
+
+// Called at the start of every render-side thread. Threads inherit the
+// creating thread's SCHED_FIFO and CPU, so drop back to SCHED_OTHER, move
+// to the render CPUs and apply the render nice level.
+void apply_render_thread_policy() {
+    static bool warned = false;
+    bool failed = false;
+
+    if (input_fifo_priority > 0) {
+        struct sched_param param = { .sched_priority = 0 };
+        failed |= pthread_setschedparam(pthread_self(), SCHED_OTHER, &param) != 0;
+    }
+    if (render_cpus_set) {
+        failed |= pthread_setaffinity_np(pthread_self(), sizeof(render_cpu_set), &render_cpu_set) != 0;
+    }
+    if (render_nice != 0) {
+        failed |= setpriority(PRIO_PROCESS, syscall(SYS_gettid), render_nice) != 0;
+    }
+
+    // Render threads start together, so claim the warning atomically
+    if (failed && !__atomic_exchange_n(&warned, true, __ATOMIC_RELAXED)) {
+        fprintf(stderr, "Warning: Could not apply render thread CPU/priority settings\n");
+    }
+}
+
 // Zoom to a specific point
 void zoom_to_point(int screen_x, int screen_y, double zoom_factor) {
     reset_idle_timer();
@@ -198,7 +596,42 @@ void zoom_to_point(int screen_x, int screen_y, double zoom_factor) {
 
     printf("Zoomed to point (%d, %d) -> complex (%.6f, %.6f), new scaling: %.6f\n",
            screen_x, screen_y, u, v, scaling);
-    redraw_flag = 1;
+    request_input_redraw();
+}
+
+// Long press: show the Julia set for the touched point, or leave it again
+void toggle_julia(int screen_x, int screen_y) {
+    reset_idle_timer();
+    pthread_mutex_lock(&param_mutex);
+
+    if (formula != FORMULA_JULIA && formula != FORMULA_MANDELBROT) {
+        // Julia sets here are z^2 + c, so c is only meaningful picked from the Mandelbrot set
+        pthread_mutex_unlock(&param_mutex);
+        printf("Long press picks a Julia constant only from the Mandelbrot set\n");
+        return;
+    } else if (formula == FORMULA_JULIA) {
+        // Back to the view the Julia set was picked from
+        scaling = pre_julia_view.scaling;
+        x_offset = pre_julia_view.x_offset;
+        y_offset = pre_julia_view.y_offset;
+        formula = pre_julia_view.formula;
+        pthread_mutex_unlock(&param_mutex);
+        printf("Leaving Julia set, back to %s\n", formula_names[formula]);
+    } else {
+        pre_julia_view.scaling = scaling;
+        pre_julia_view.x_offset = x_offset;
+        pre_julia_view.y_offset = y_offset;
+        pre_julia_view.formula = formula;
+
+        // The touched point becomes the Julia constant c
+        julia_re = screen_x * scaling - x_offset;
+        julia_im = screen_y * scaling - y_offset;
+        set_initial_view(FORMULA_JULIA);
+        pthread_mutex_unlock(&param_mutex);
+        printf("Julia set for c = (%.6f, %.6f)\n", julia_re, julia_im);
+    }
+
+    request_input_redraw();
 }
 
 // Query touch device capabilities to get coordinate ranges
@@ -238,6 +671,7 @@ void* touch_handler(void* arg __attribute__((unused))) {
     struct input_event ev;
     int touch_x = -1, touch_y = -1;
     bool touch_active = false;
+    long touch_start_ms = 0;
     while (!quit_flag) {
         ssize_t n = read(touch_fd, &ev, sizeof(ev));
 
@@ -252,8 +686,9 @@ void* touch_handler(void* arg __attribute__((unused))) {
                 if (ev.value == 1) {
                     // Touch pressed
                     touch_active = true;
+                    touch_start_ms = get_time_ms();
                 } else if (ev.value == 0 && touch_active) {
-                    // Touch released - trigger zoom
+                    // Touch released - trigger zoom, or Julia toggle on a long press
                     if (touch_x >= 0 && touch_y >= 0) {
                         // Scale touch coordinates to screen coordinates
                         // Display is rotated 90 degrees, so transform coordinates
@@ -264,7 +699,11 @@ void* touch_handler(void* arg __attribute__((unused))) {
                         if (screen_x >= 0 && screen_x < width &&
                             screen_y >= 0 && screen_y < height) {
                             printf("Touch detected at screen position (%d, %d)\n", screen_x, screen_y);
-                            zoom_to_point(screen_x, screen_y, 0.9);  // Zoom in by 10%
+                            if (get_time_ms() - touch_start_ms >= JULIA_HOLD_MS) {
+                                toggle_julia(screen_x, screen_y);
+                            } else {
+                                zoom_to_point(screen_x, screen_y, 0.9);  // Zoom in by 10%
+                            }
                         }
                     }
                     touch_active = false;
@@ -275,7 +714,12 @@ void* touch_handler(void* arg __attribute__((unused))) {
             break;
         }
 
-        usleep(10000);  // Sleep 10ms between reads
+        // Drain queued events back to back; once empty, sleep until the next
+        // event arrives rather than on a fixed 10ms tick
+        if (n != sizeof(ev)) {
+            struct pollfd pfd = { .fd = touch_fd, .events = POLLIN };
+            poll(&pfd, 1, TOUCH_POLL_TIMEOUT_MS);
+        }
     }
 
     close(touch_fd);
@@ -381,6 +825,11 @@ void* button_handler(void* arg __attribute__((unused))) {
                         if (pthread_mutex_trylock(&param_mutex) == 0) {
                             FILE* save_file = fopen("saved_view.txt", "a");
                             if (save_file) {
+                                fprintf(save_file, "formula=%s\n", formula_names[formula]);
+                                if (formula == FORMULA_JULIA) {
+                                    fprintf(save_file, "julia_re=%.10f\n", julia_re);
+                                    fprintf(save_file, "julia_im=%.10f\n", julia_im);
+                                }
                                 fprintf(save_file, "scaling=%.10f\n", scaling);
                                 fprintf(save_file, "x_offset=%.10f\n", x_offset);
                                 fprintf(save_file, "y_offset=%.10f\n", y_offset);
@@ -393,6 +842,9 @@ void* button_handler(void* arg __attribute__((unused))) {
                                     saved_views[num_saved_views].x_offset = x_offset;
                                     saved_views[num_saved_views].y_offset = y_offset;
                                     saved_views[num_saved_views].colour_offset = colour_offset;
+                                    saved_views[num_saved_views].formula = formula;
+                                    saved_views[num_saved_views].julia_re = julia_re;
+                                    saved_views[num_saved_views].julia_im = julia_im;
                                     num_saved_views++;
                                     printf("  -> View saved (now %d saved views in animation)\n", num_saved_views);
                                 } else {
@@ -413,19 +865,19 @@ void* button_handler(void* arg __attribute__((unused))) {
                     case 2:  // Button 3 - Reset to initial view
                         printf("  -> Reset view\n");
                         pthread_mutex_lock(&param_mutex);
-                        scaling = 0.013;
-                        x_offset = 2.6;
-                        y_offset = 1.6;
+                        set_initial_view(initial_formula);
+                        julia_re = JULIA_DEFAULT_RE;
+                        julia_im = JULIA_DEFAULT_IM;
                         colour_offset = 0;
                         pthread_mutex_unlock(&param_mutex);
-                        redraw_flag = 1;
+                        request_input_redraw();
                         break;
                     case 3:  // Button 4 - Cycle color palette
                         pthread_mutex_lock(&param_mutex);
                         colour_offset = (colour_offset + 1) % COLOUR_SCALE;
                         pthread_mutex_unlock(&param_mutex);
                         printf("  -> Color cycle (offset: %d/%d)\n", colour_offset, COLOUR_SCALE);
-                        redraw_flag = 1;
+                        request_input_redraw();
                         break;
                 }
             }
@@ -455,6 +907,12 @@ void cleanup() {
     if (fb_fd >= 0) {
         close(fb_fd);
     }
+    free(frame_iterations);
+    free(frame_pixels);
+    if (frame_export) {
+        munmap(frame_export, frame_export_size);
+        shm_unlink(frame_export_name);
+    }
     pthread_mutex_destroy(&param_mutex);
 }
 
@@ -469,208 +927,1817 @@ typedef struct {
     double x_offset;
     double y_offset;
     int colour_offset;
+    int formula;
+    double julia_re;
+    double julia_im;
+    int pixel_format;
+    uint16_t* iters;  // Optional per-pixel iteration counts (NULL to skip)
+    bool completed;             // Result: false if the band was abandoned
+    int rows_rendered;          // Result: rows written before completing or abandoning
+    uint64_t iterations;        // Result: iterations spent on the band
+    uint64_t short_circuited;   // Result: pixels resolved by the SKIP test
+    int64_t busy_us;            // Result: time spent rendering the band
 } render_worker_args_t;
 
-// Worker thread function for parallel Mandelbrot rendering
+// Framebuffer pixel formats with their own render kernels
+enum { PIXEL_FORMAT_GENERIC, PIXEL_FORMAT_RGB565, PIXEL_FORMAT_RGB24, PIXEL_FORMAT_RGB32, NUM_PIXEL_FORMATS };
+
+int pixel_format_of(struct fb_var_screeninfo* vinfo) {
+    switch (vinfo->bits_per_pixel) {
+        case 16: return PIXEL_FORMAT_RGB565;
+        case 24: return PIXEL_FORMAT_RGB24;
+        case 32: return PIXEL_FORMAT_RGB32;
+        default: return PIXEL_FORMAT_GENERIC;
+    }
+}
+
+// Pixel writers for the band kernels; row points at pixel 0 of the row
+#define PUT_PIXEL_GENERIC(row, i, j, r, g, b) \
+    set_pixel_fb(args->fbp, args->vinfo, args->finfo, i, j, r, g, b);
+#define PUT_PIXEL_RGB565(row, i, j, r, g, b) \
+    ((uint16_t*)(row))[i] = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+#define PUT_PIXEL_RGB24(row, i, j, r, g, b) \
+    { uint8_t* p = (row) + (i) * 3; p[0] = b; p[1] = g; p[2] = r; }
+#define PUT_PIXEL_RGB32(row, i, j, r, g, b) \
+    { uint8_t* p = (row) + (i) * 4; p[0] = b; p[1] = g; p[2] = r; p[3] = 255; }
+
+// Render a band of rows for one formula x pixel format, MAXI iterations.
+// Stops early (leaving completed false) if the frame is cancelled.
+#define DEFINE_BAND_KERNEL(name, fmt, BYTES, PUT, INIT, STEP, SKIP) \
+void render_band_##name##_##fmt(render_worker_args_t* args) { \
+    double jr __attribute__((unused)) = args->julia_re; \
+    double ji __attribute__((unused)) = args->julia_im; \
+    uint64_t iterations = 0; \
+    uint64_t short_circuited = 0; \
+    int j; \
+    for (j = args->start_row; j < args->end_row && !frame_cancelled(); j++) { \
+        uint8_t* row __attribute__((unused)) = (uint8_t*)args->fbp + \
+            (j + args->vinfo->yoffset) * args->finfo->line_length + args->vinfo->xoffset * (BYTES); \
+        double v = j * args->scaling - args->y_offset; \
+        for (int i = 0; i < width; i++) { \
+            double u = i * args->scaling - args->x_offset; \
+            int n; \
+            if (SKIP) { \
+                n = MAXI; \
+                short_circuited++; \
+            } else { \
+                ITERATE(INIT, STEP, MAXI, n) \
+                iterations += n; \
+            } \
+            if (args->iters) { \
+                args->iters[j * width + i] = n; \
+            } \
+            uint8_t r, g, b; \
+            iteration_colour(n, args->colour_offset, &r, &g, &b); \
+            PUT(row, i, j, r, g, b) \
+        } \
+    } \
+    args->completed = (j == args->end_row); \
+    args->rows_rendered = j - args->start_row; \
+    args->iterations = iterations; \
+    args->short_circuited = short_circuited; \
+}
+
+#define DEFINE_BAND_KERNELS(ID, name, INIT, STEP, SKIP) \
+    DEFINE_BAND_KERNEL(name, generic, 0, PUT_PIXEL_GENERIC, INIT, STEP, SKIP) \
+    DEFINE_BAND_KERNEL(name, rgb565, 2, PUT_PIXEL_RGB565, INIT, STEP, SKIP) \
+    DEFINE_BAND_KERNEL(name, rgb24, 3, PUT_PIXEL_RGB24, INIT, STEP, SKIP) \
+    DEFINE_BAND_KERNEL(name, rgb32, 4, PUT_PIXEL_RGB32, INIT, STEP, SKIP)
+FORMULA_LIST(DEFINE_BAND_KERNELS)
+
+typedef void (*band_kernel_fn)(render_worker_args_t* args);
+
+#define BAND_KERNEL_ROW(ID, name, INIT, STEP, SKIP) \
+    { render_band_##name##_generic, render_band_##name##_rgb565, \
+      render_band_##name##_rgb24, render_band_##name##_rgb32 },
+band_kernel_fn band_kernels[NUM_FORMULAS][NUM_PIXEL_FORMATS] = { FORMULA_LIST(BAND_KERNEL_ROW) };
+
+// Worker thread function for parallel rendering: runs the kernel specialised
+// for this frame's formula and the framebuffer's pixel format
 void* render_worker_thread(void* arg) {
     render_worker_args_t* args = (render_worker_args_t*)arg;
+    apply_render_thread_policy();
+    int64_t start_us = get_time_us();
 
-    // Render assigned rows
-    for (int j = args->start_row; j < args->end_row && !quit_flag; j++) {
-        for (int i = 0; i < width && !quit_flag; i++) {
-            // Convert pixel coordinates to complex plane coordinates
-            double u = i * args->scaling - args->x_offset;
-            double v = j * args->scaling - args->y_offset;
+    band_kernels[args->formula][args->pixel_format](args);
 
-            // Calculate iterations for this point
-            int n = mandelbrot_iterations(u, v);
-
-            // Calculate color based on iteration count
-            if (n == MAXI) {
-                // Point is in the set - color it black
-                set_pixel_fb(args->fbp, args->vinfo, args->finfo, i, j, 0, 0, 0);
-            } else {
-                // Point escaped - color based on iteration count with offset
-                float hue = fmod((n * 360.0 * COLOUR_SCALE) / MAXI + args->colour_offset * 360.0 / COLOUR_SCALE, 360.0);
-                uint8_t r, g, b;
-                hsb_to_rgb(hue, 1.0, 1.0, &r, &g, &b);
-                set_pixel_fb(args->fbp, args->vinfo, args->finfo, i, j, r, g, b);
-            }
-        }
-    }
+    args->busy_us = get_time_us() - start_us;
 
     return NULL;
 }
 
-// Render Mandelbrot set to framebuffer (multi-threaded)
-void render_mandelbrot(char* fbp, struct fb_var_screeninfo* vinfo,
-                       struct fb_fix_screeninfo* finfo) {
-    double local_scaling, local_x_offset, local_y_offset;
-    int local_colour_offset;
-    struct timespec start_time, end_time;
-
-    // Copy parameters with mutex protection
-    pthread_mutex_lock(&param_mutex);
-    local_scaling = scaling;
-    local_x_offset = x_offset;
-    local_y_offset = y_offset;
-    local_colour_offset = colour_offset;
-    pthread_mutex_unlock(&param_mutex);
+// ---------------------------------------------------------------------------
+// Distributed tile rendering
+//
+// A worker (-w PORT) accepts tile jobs over TCP and replies with the tile's
+// iteration counts. A coordinator (-W host:port,...) splits each frame into
+// TILE_SIZE tiles and hands them out over WORKER_CONNECTIONS connections per
+// worker; tiles that time out or whose connection drops go back in the queue,
+// and anything no worker could deliver is rendered locally.
+//
+// All integers on the wire are big-endian; doubles are sent as their IEEE-754
+// bit pattern. Job: magic, job_id, scaling, x_offset, y_offset, tile_x,
+// tile_y, tile_w, tile_h, max_iter, formula, julia_re, julia_im. Reply: magic, job_id, encoding,
+// pixel_count, payload_len, then payload_len bytes of iteration data.
+// ---------------------------------------------------------------------------
+
+// A rectangle of the complex plane to iterate, as sent to a worker
+typedef struct {
+    uint32_t job_id;
+    double scaling;
+    double x_offset;
+    double y_offset;
+    int tile_x;
+    int tile_y;
+    int tile_w;
+    int tile_h;
+    int max_iter;
+    int formula;
+    double julia_re;
+    double julia_im;
+} tile_job_t;
+
+void put_u16(uint8_t* p, uint16_t v) {
+    v = htobe16(v);
+    memcpy(p, &v, sizeof(v));
+}
 
-    printf("Rendering Mandelbrot set (scaling=%.6f, x_off=%.6f, y_off=%.6f)...\n",
-           local_scaling, local_x_offset, local_y_offset);
+void put_u32(uint8_t* p, uint32_t v) {
+    v = htobe32(v);
+    memcpy(p, &v, sizeof(v));
+}
 
-    // Start timing
-    clock_gettime(CLOCK_MONOTONIC, &start_time);
+void put_f64(uint8_t* p, double d) {
+    uint64_t v;
+    memcpy(&v, &d, sizeof(v));
+    v = htobe64(v);
+    memcpy(p, &v, sizeof(v));
+}
 
-    // Multi-threaded rendering: divide screen into horizontal bands
-    #define NUM_RENDER_THREADS 4
-    pthread_t render_threads[NUM_RENDER_THREADS];
-    render_worker_args_t worker_args[NUM_RENDER_THREADS];
+uint16_t get_u16(const uint8_t* p) {
+    uint16_t v;
+    memcpy(&v, p, sizeof(v));
+    return be16toh(v);
+}
 
-    // Calculate rows per thread
-    int rows_per_thread = height / NUM_RENDER_THREADS;
+uint32_t get_u32(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return be32toh(v);
+}
 
-    // Create worker threads
-    for (int t = 0; t < NUM_RENDER_THREADS; t++) {
-        worker_args[t].fbp = fbp;
-        worker_args[t].vinfo = vinfo;
-        worker_args[t].finfo = finfo;
-        worker_args[t].start_row = t * rows_per_thread;
-        worker_args[t].end_row = (t == NUM_RENDER_THREADS - 1) ? height : (t + 1) * rows_per_thread;
-        worker_args[t].scaling = local_scaling;
-        worker_args[t].x_offset = local_x_offset;
-        worker_args[t].y_offset = local_y_offset;
-        worker_args[t].colour_offset = local_colour_offset;
+double get_f64(const uint8_t* p) {
+    uint64_t v;
+    double d;
+    memcpy(&v, p, sizeof(v));
+    v = be64toh(v);
+    memcpy(&d, &v, sizeof(d));
+    return d;
+}
 
-        if (pthread_create(&render_threads[t], NULL, render_worker_thread, &worker_args[t]) != 0) {
-            fprintf(stderr, "Error: Failed to create render thread %d\n", t);
+// Send the whole buffer, returning false if the peer went away
+bool send_all(int fd, const void* buf, size_t len) {
+    const uint8_t* p = buf;
+    while (len > 0) {
+        ssize_t n = send(fd, p, len, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
         }
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        len -= n;
     }
+    return true;
+}
 
-    // Wait for all worker threads to complete
-    for (int t = 0; t < NUM_RENDER_THREADS; t++) {
-        pthread_join(render_threads[t], NULL);
+// Receive exactly len bytes, returning false on EOF, error or timeout
+bool recv_all(int fd, void* buf, size_t len) {
+    uint8_t* p = buf;
+    while (len > 0) {
+        ssize_t n = recv(fd, p, len, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        len -= n;
     }
+    return true;
+}
 
-    // End timing and calculate elapsed time in milliseconds
-    clock_gettime(CLOCK_MONOTONIC, &end_time);
-    long elapsed_ms = (end_time.tv_sec - start_time.tv_sec) * 1000 +
-                      (end_time.tv_nsec - start_time.tv_nsec) / 1000000;
+void encode_tile_job(uint8_t* buf, const tile_job_t* job) {
+    put_u32(buf, TILE_PROTO_MAGIC);
+    put_u32(buf + 4, job->job_id);
+    put_f64(buf + 8, job->scaling);
+    put_f64(buf + 16, job->x_offset);
+    put_f64(buf + 24, job->y_offset);
+    put_u32(buf + 32, job->tile_x);
+    put_u32(buf + 36, job->tile_y);
+    put_u32(buf + 40, job->tile_w);
+    put_u32(buf + 44, job->tile_h);
+    put_u32(buf + 48, job->max_iter);
+    put_u32(buf + 52, job->formula);
+    put_f64(buf + 56, job->julia_re);
+    put_f64(buf + 64, job->julia_im);
+}
 
-    printf("Render complete in %ld ms (4 threads).\n", elapsed_ms);
+// Decode and validate a job; returns false for anything a worker should not run
+bool decode_tile_job(const uint8_t* buf, tile_job_t* job) {
+    if (get_u32(buf) != TILE_PROTO_MAGIC) {
+        return false;
+    }
+    job->job_id = get_u32(buf + 4);
+    job->scaling = get_f64(buf + 8);
+    job->x_offset = get_f64(buf + 16);
+    job->y_offset = get_f64(buf + 24);
+    job->tile_x = (int32_t)get_u32(buf + 32);
+    job->tile_y = (int32_t)get_u32(buf + 36);
+    job->tile_w = (int32_t)get_u32(buf + 40);
+    job->tile_h = (int32_t)get_u32(buf + 44);
+    job->max_iter = (int32_t)get_u32(buf + 48);
+    job->formula = (int32_t)get_u32(buf + 52);
+    job->julia_re = get_f64(buf + 56);
+    job->julia_im = get_f64(buf + 64);
+
+    return job->tile_w > 0 && job->tile_h > 0 &&
+           job->tile_w <= TILE_MAX_PIXELS / job->tile_h &&
+           job->max_iter > 0 && job->max_iter <= UINT16_MAX &&
+           job->formula >= 0 && job->formula < NUM_FORMULAS;
 }
 
-// Load saved views from file
-void load_saved_views(const char* filename) {
-    FILE* file = fopen(filename, "r");
-    if (!file) {
-        printf("No saved views file found (%s), starting fresh.\n", filename);
-        return;
+// Iterate every pixel of a tile for one formula, writing counts into out
+// (row pitch = stride). Jobs at the usual MAXI get the fixed-limit loop.
+// Returns false if quit_flag cut the tile short, leaving rows unwritten.
+#define TILE_ROWS(INIT, STEP, SKIP, LIMIT) \
+    for (j = 0; j < job->tile_h && !quit_flag; j++) { \
+        double v = (job->tile_y + j) * job->scaling - job->y_offset; \
+        for (int i = 0; i < job->tile_w; i++) { \
+            double u = (job->tile_x + i) * job->scaling - job->x_offset; \
+            int n; \
+            if (SKIP) { \
+                n = (LIMIT); \
+            } else ITERATE(INIT, STEP, LIMIT, n) \
+            out[j * stride + i] = n; \
+        } \
     }
 
-    num_saved_views = 0;
-    char line[256];
-    saved_view_t current_view = {0};
-    int fields_read = 0;
+#define DEFINE_TILE_KERNEL(ID, name, INIT, STEP, SKIP) \
+bool compute_tile_##name(const tile_job_t* job, uint16_t* out, int stride) { \
+    double jr __attribute__((unused)) = job->julia_re; \
+    double ji __attribute__((unused)) = job->julia_im; \
+    int max_iter = job->max_iter; \
+    int j; \
+    if (max_iter == MAXI) { \
+        TILE_ROWS(INIT, STEP, SKIP, MAXI) \
+    } else { \
+        TILE_ROWS(INIT, STEP, SKIP, max_iter) \
+    } \
+    return j == job->tile_h; \
+}
+FORMULA_LIST(DEFINE_TILE_KERNEL)
 
-    while (fgets(line, sizeof(line), file) && num_saved_views < MAX_SAVED_VIEWS) {
-        if (sscanf(line, "scaling=%lf", &current_view.scaling) == 1) {
-            fields_read++;
-        } else if (sscanf(line, "x_offset=%lf", &current_view.x_offset) == 1) {
-            fields_read++;
-        } else if (sscanf(line, "y_offset=%lf", &current_view.y_offset) == 1) {
-            fields_read++;
-        } else if (sscanf(line, "colour_offset=%d", &current_view.colour_offset) == 1) {
-            fields_read++;
+typedef bool (*tile_kernel_fn)(const tile_job_t* job, uint16_t* out, int stride);
+
+#define TILE_KERNEL_ENTRY(ID, name, INIT, STEP, SKIP) compute_tile_##name,
+tile_kernel_fn tile_kernels[NUM_FORMULAS] = { FORMULA_LIST(TILE_KERNEL_ENTRY) };
+
+// Iterate every pixel of a tile, writing counts into out (row pitch = stride).
+// Returns false if the tile was cut short by quit_flag.
+bool compute_tile_iterations(const tile_job_t* job, uint16_t* out, int stride) {
+    return tile_kernels[job->formula](job, out, stride);
+}
+
+// Run-length encode iteration counts as (run, value) pairs. Escape bands give
+// long runs, so most tiles shrink several-fold; returns the encoded length,
+// which the caller compares against the raw size.
+size_t rle_encode_iterations(const uint16_t* in, int count, uint8_t* out) {
+    size_t len = 0;
+    int i = 0;
+    while (i < count) {
+        uint16_t value = in[i];
+        int run = 1;
+        while (i + run < count && in[i + run] == value && run < UINT16_MAX) {
+            run++;
         }
+        put_u16(out + len, run);
+        put_u16(out + len + 2, value);
+        len += 4;
+        i += run;
+    }
+    return len;
+}
 
-        // If we've read all 4 fields, save the view
-        if (fields_read == 4) {
-            saved_views[num_saved_views++] = current_view;
-            fields_read = 0;
-            memset(&current_view, 0, sizeof(current_view));
+// Decode a tile payload into count iteration values; false if malformed
+bool decode_tile_payload(const uint8_t* in, size_t len, uint32_t encoding,
+                         uint16_t* out, int count) {
+    if (encoding == TILE_ENCODING_RAW) {
+        if (len != (size_t)count * 2) {
+            return false;
         }
+        for (int i = 0; i < count; i++) {
+            out[i] = get_u16(in + i * 2);
+        }
+        return true;
     }
 
-    fclose(file);
-    printf("Loaded %d saved view(s) from %s\n", num_saved_views, filename);
+    if (encoding != TILE_ENCODING_RLE || len % 4 != 0) {
+        return false;
+    }
+    int pos = 0;
+    for (size_t k = 0; k < len; k += 4) {
+        int run = get_u16(in + k);
+        uint16_t value = get_u16(in + k + 2);
+        if (run > count - pos) {
+            return false;
+        }
+        for (int r = 0; r < run; r++) {
+            out[pos++] = value;
+        }
+    }
+    return pos == count;
 }
 
-void print_usage(const char* prog_name) {
-    printf("Usage: %s [options]\n", prog_name);
-    printf("Options:\n");
-    printf("  -d, --device <device>  Framebuffer device (default: /dev/fb1)\n");
-    printf("  -t, --touch <device>   Touch input device (default: /dev/input/event4)\n");
-    printf("  -h, --help             Show this help message\n");
-    printf("\nExamples:\n");
-    printf("  %s                     # Use TFT display (/dev/fb1)\n", prog_name);
-    printf("  %s -d /dev/fb0         # Use HDMI display\n", prog_name);
-    printf("  %s -t /dev/input/event0  # Use different touch device\n", prog_name);
-}
+// Serve tile jobs on one accepted connection until the peer disconnects
+void* tile_connection_thread(void* arg) {
+    int fd = (int)(intptr_t)arg;
+    uint8_t job_buf[TILE_JOB_BYTES];
+
+    apply_render_thread_policy();
+    uint8_t reply[TILE_REPLY_BYTES];
+    uint16_t* iters = malloc(TILE_MAX_PIXELS * sizeof(uint16_t));
+    uint8_t* payload = malloc(TILE_MAX_PIXELS * 4);
+    int tiles_served = 0;
+
+    while (iters && payload && !quit_flag && recv_all(fd, job_buf, TILE_JOB_BYTES)) {
+        tile_job_t job;
+        if (!decode_tile_job(job_buf, &job)) {
+            fprintf(stderr, "Worker: rejecting malformed tile job\n");
+            break;
+        }
 
-int main(int argc, char* argv[]) {
+        int count = job.tile_w * job.tile_h;
+        if (!compute_tile_iterations(&job, iters, job.tile_w)) {
+            // Unwritten rows hold the previous job's counts; close without replying
+            break;
+        }
 
-    // Parse command-line arguments
-    for (int i = 1; i < argc; i++) {
-        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
-            print_usage(argv[0]);
-            return 0;
-        } else if (strcmp(argv[i], "-d") == 0 || strcmp(argv[i], "--device") == 0) {
-            if (i + 1 < argc) {
-                fb_device = argv[++i];
-            } else {
-                fprintf(stderr, "Error: -d/--device requires an argument\n");
-                print_usage(argv[0]);
-                return 1;
-            }
-        } else if (strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--touch") == 0) {
-            if (i + 1 < argc) {
-                touch_device = argv[++i];
-            } else {
-                fprintf(stderr, "Error: -t/--touch requires an argument\n");
-                print_usage(argv[0]);
-                return 1;
+        // Fall back to raw counts when the tile is too noisy for RLE to win
+        uint32_t encoding = TILE_ENCODING_RLE;
+        size_t payload_len = rle_encode_iterations(iters, count, payload);
+        if (payload_len >= (size_t)count * 2) {
+            encoding = TILE_ENCODING_RAW;
+            payload_len = (size_t)count * 2;
+            for (int i = 0; i < count; i++) {
+                put_u16(payload + i * 2, iters[i]);
             }
-        } else {
-            fprintf(stderr, "Error: Unknown option '%s'\n", argv[i]);
-            print_usage(argv[0]);
-            return 1;
         }
+
+        put_u32(reply, TILE_PROTO_MAGIC);
+        put_u32(reply + 4, job.job_id);
+        put_u32(reply + 8, encoding);
+        put_u32(reply + 12, count);
+        put_u32(reply + 16, payload_len);
+        if (!send_all(fd, reply, TILE_REPLY_BYTES) || !send_all(fd, payload, payload_len)) {
+            break;
+        }
+        tiles_served++;
     }
 
-    // Set up signal handler for Ctrl+C
-    signal(SIGINT, signal_handler);
+    printf("Worker: connection closed after %d tile(s)\n", tiles_served);
+    free(iters);
+    free(payload);
+    close(fd);
+    return NULL;
+}
 
-    // Open framebuffer device
-    fb_fd = open(fb_device, O_RDWR);
-    if (fb_fd < 0) {
-        fprintf(stderr, "Error opening %s: ", fb_device);
-        perror("");
-        return 1;
-    }
-    
-    // Get fixed screen information
-    if (ioctl(fb_fd, FBIOGET_FSCREENINFO, &finfo) == -1) {
-        perror("Error reading fixed information");
-        close(fb_fd);
+// Worker mode: accept coordinator connections and serve tiles until Ctrl+C
+int run_tile_worker(int port) {
+    int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd < 0) {
+        perror("Error creating worker socket");
         return 1;
     }
-    
-    // Get variable screen information
-    if (ioctl(fb_fd, FBIOGET_VSCREENINFO, &vinfo) == -1) {
-        perror("Error reading variable information");
-        close(fb_fd);
+
+    int one = 1;
+    setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    if (bind(listen_fd, (struct sockaddr*)&addr, sizeof(addr)) < 0 || listen(listen_fd, 16) < 0) {
+        fprintf(stderr, "Error listening on port %d: %s\n", port, strerror(errno));
+        close(listen_fd);
         return 1;
     }
-    
-    // Set runtime dimensions from framebuffer
-    width = vinfo.xres;
-    height = vinfo.yres;
 
-    printf("Framebuffer device: %s\n", fb_device);
-    printf("  Display: %s\n", finfo.id);
-    printf("  Resolution: %dx%d\n", width, height);
+    printf("Tile worker listening on port %d. Press Ctrl+C to exit.\n", port);
+
+    // Poll so Ctrl+C is noticed even though signal() restarts accept()
+    struct pollfd pfd = { .fd = listen_fd, .events = POLLIN };
+    while (!quit_flag) {
+        if (poll(&pfd, 1, 200) <= 0) {
+            continue;
+        }
+        int fd = accept(listen_fd, NULL, NULL);
+        if (fd < 0) {
+            continue;
+        }
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        pthread_t conn_thread;
+        if (pthread_create(&conn_thread, NULL, tile_connection_thread, (void*)(intptr_t)fd) != 0) {
+            fprintf(stderr, "Warning: Failed to create worker connection thread\n");
+            close(fd);
+            continue;
+        }
+        pthread_detach(conn_thread);
+    }
+
+    printf("\nWorker exiting...\n");
+    close(listen_fd);
+    return 0;
+}
+
+// Parse a comma-separated host:port list into WORKER_CONNECTIONS slots each
+bool parse_remote_workers(const char* list) {
+    char buf[1024];
+    snprintf(buf, sizeof(buf), "%s", list);
+
+    for (char* entry = strtok(buf, ","); entry; entry = strtok(NULL, ",")) {
+        char* colon = strrchr(entry, ':');
+        if (!colon || colon == entry || colon[1] == '\0' ||
+            strlen(entry) - strlen(colon) >= sizeof(remote_workers[0].host) ||
+            strlen(colon + 1) >= sizeof(remote_workers[0].port)) {
+            fprintf(stderr, "Error: invalid worker '%s' (expected host:port)\n", entry);
+            return false;
+        }
+        if (num_remote_workers + WORKER_CONNECTIONS > MAX_REMOTE_WORKERS * WORKER_CONNECTIONS) {
+            fprintf(stderr, "Error: at most %d workers supported\n", MAX_REMOTE_WORKERS);
+            return false;
+        }
+        *colon = '\0';
+        for (int c = 0; c < WORKER_CONNECTIONS; c++) {
+            remote_worker_t* w = &remote_workers[num_remote_workers++];
+            snprintf(w->host, sizeof(w->host), "%s", entry);
+            snprintf(w->port, sizeof(w->port), "%s", colon + 1);
+            w->fd = -1;
+            w->failures = 0;
+            w->retry_after = 0;
+        }
+    }
+    return num_remote_workers > 0;
+}
+
+// Open a connection to a worker with connect and I/O timeouts applied
+int connect_remote_worker(remote_worker_t* w) {
+    struct addrinfo hints, *res;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(w->host, w->port, &hints, &res) != 0) {
+        return -1;
+    }
+
+    int fd = -1;
+    for (struct addrinfo* ai = res; ai && fd < 0; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        // SO_SNDTIMEO also bounds connect() on Linux
+        struct timeval tv = { WORKER_CONNECT_TIMEOUT_MS / 1000, (WORKER_CONNECT_TIMEOUT_MS % 1000) * 1000 };
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+        if (connect(fd, ai->ai_addr, ai->ai_addrlen) < 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(res);
+
+    if (fd >= 0) {
+        int one = 1;
+        struct timeval tv = { TILE_TIMEOUT_MS / 1000, (TILE_TIMEOUT_MS % 1000) * 1000 };
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    return fd;
+}
+
+// Tile states within a frame
+enum { TILE_PENDING, TILE_IN_FLIGHT, TILE_DONE };
+
+// Per-tile dispatch state
+typedef struct {
+    uint8_t state;
+    uint8_t copies;       // Threads currently working on the tile
+    long dispatched_ms;   // When the tile was last handed out
+} tile_status_t;
+
+// Shared state for one tiled frame, guarded by mutex
+typedef struct {
+    uint16_t* iters;
+    int width;
+    int height;
+    double scaling;
+    double x_offset;
+    double y_offset;
+    int formula;
+    double julia_re;
+    double julia_im;
+    int tiles_x;
+    int num_tiles;
+    tile_status_t* tiles;
+    int tiles_done;
+    int remote_active;    // Remote tile threads still running
+    int tiles_remote;
+    int tiles_redispatched;
+    long bytes_received;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+} tile_frame_t;
+
+typedef struct {
+    tile_frame_t* frame;
+    remote_worker_t* worker;
+} remote_tile_args_t;
+
+// Fill in the job describing tile index within the frame
+void tile_frame_job(const tile_frame_t* f, int index, tile_job_t* job) {
+    job->job_id = index;
+    job->scaling = f->scaling;
+    job->x_offset = f->x_offset;
+    job->y_offset = f->y_offset;
+    job->tile_x = (index % f->tiles_x) * TILE_SIZE;
+    job->tile_y = (index / f->tiles_x) * TILE_SIZE;
+    job->tile_w = (job->tile_x + TILE_SIZE > f->width) ? f->width - job->tile_x : TILE_SIZE;
+    job->tile_h = (job->tile_y + TILE_SIZE > f->height) ? f->height - job->tile_y : TILE_SIZE;
+    job->max_iter = MAXI;
+    job->formula = f->formula;
+    job->julia_re = f->julia_re;
+    job->julia_im = f->julia_im;
+}
+
+// Find a tile to hand out: a pending one, else one that has been in flight
+// for TILE_STRAGGLER_MS since it was last handed out, so a slow or silent
+// worker cannot hold up the frame. Caller holds f->mutex.
+int next_claimable_tile(tile_frame_t* f) {
+    long now = get_time_ms();
+    int straggler = -1;
+    for (int t = 0; t < f->num_tiles; t++) {
+        if (f->tiles[t].state == TILE_PENDING) {
+            return t;
+        }
+        if (straggler < 0 && f->tiles[t].state == TILE_IN_FLIGHT &&
+            now - f->tiles[t].dispatched_ms >= TILE_STRAGGLER_MS) {
+            straggler = t;
+        }
+    }
+    return straggler;
+}
+
+// Claim the next tile. With wait set, blocks while other threads still hold
+// tiles in flight in case one of them is handed back or starts to straggle.
+// Returns -1 once no tile is left to claim.
+int claim_tile(tile_frame_t* f, bool wait) {
+    int index = -1;
+    pthread_mutex_lock(&f->mutex);
+    while (!frame_cancelled() && f->tiles_done < f->num_tiles) {
+        index = next_claimable_tile(f);
+        if (index >= 0) {
+            if (f->tiles[index].state == TILE_IN_FLIGHT) {
+                f->tiles_redispatched++;
+            }
+            f->tiles[index].state = TILE_IN_FLIGHT;
+            f->tiles[index].copies++;
+            f->tiles[index].dispatched_ms = get_time_ms();
+            break;
+        }
+        if (!wait) {
+            break;
+        }
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += 100000000;
+        if (deadline.tv_nsec >= 1000000000) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
+        }
+        pthread_cond_timedwait(&f->cond, &f->mutex, &deadline);
+    }
+    pthread_mutex_unlock(&f->mutex);
+    return index;
+}
+
+// Copy a claimed tile's iteration counts into the frame, or hand the tile
+// back for re-dispatch if it was lost (tile is NULL). The first copy of a
+// re-dispatched tile to arrive wins; later ones are dropped.
+void finish_tile(tile_frame_t* f, int index, const uint16_t* tile, bool remote, long bytes) {
+    tile_job_t job;
+    tile_frame_job(f, index, &job);
+
+    pthread_mutex_lock(&f->mutex);
+    tile_status_t* status = &f->tiles[index];
+    status->copies--;
+    if (tile && status->state != TILE_DONE) {
+        for (int j = 0; j < job.tile_h; j++) {
+            memcpy(f->iters + (job.tile_y + j) * f->width + job.tile_x,
+                   tile + j * job.tile_w, job.tile_w * sizeof(uint16_t));
+        }
+        status->state = TILE_DONE;
+        f->tiles_done++;
+        if (remote) {
+            f->tiles_remote++;
+            f->bytes_received += bytes;
+        }
+    } else if (!tile && status->state == TILE_IN_FLIGHT && status->copies == 0) {
+        status->state = TILE_PENDING;
+        f->tiles_redispatched++;
+    }
+    pthread_cond_broadcast(&f->cond);
+    pthread_mutex_unlock(&f->mutex);
+}
+
+bool tile_done(tile_frame_t* f, int index) {
+    pthread_mutex_lock(&f->mutex);
+    bool done = f->tiles[index].state == TILE_DONE;
+    pthread_mutex_unlock(&f->mutex);
+    return done;
+}
+
+// Render claimed tiles on this machine until none is left to claim
+void render_claimed_tiles(tile_frame_t* f) {
+    tile_job_t job;
+    int index;
+
+    uint16_t* tile = malloc(TILE_SIZE * TILE_SIZE * sizeof(uint16_t));
+    while (tile && (index = claim_tile(f, false)) >= 0) {
+        tile_frame_job(f, index, &job);
+        bool ok = compute_tile_iterations(&job, tile, job.tile_w);
+        finish_tile(f, index, ok ? tile : NULL, false, 0);
+    }
+    free(tile);
+}
+
+void* local_tile_thread(void* arg) {
+    apply_render_thread_policy();
+    render_claimed_tiles((tile_frame_t*)arg);
+    return NULL;
+}
+
+// Wait for a worker's reply in TILE_POLL_MS slices, giving up after
+// TILE_TIMEOUT_MS, when the frame is cancelled or once another thread has
+// delivered the tile
+bool wait_for_tile_reply(int fd, tile_frame_t* f, int index) {
+    struct pollfd pfd = { .fd = fd, .events = POLLIN };
+    long deadline = get_time_ms() + TILE_TIMEOUT_MS;
+    while (!frame_cancelled() && !tile_done(f, index) && get_time_ms() < deadline) {
+        if (poll(&pfd, 1, TILE_POLL_MS) > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Send one tile to a worker and decode the reply into tile.
+// Returns the number of bytes received, or -1 if the tile was lost.
+long fetch_remote_tile(int fd, tile_frame_t* f, int index, uint16_t* tile, uint8_t* payload) {
+    tile_job_t job;
+    uint8_t job_buf[TILE_JOB_BYTES];
+    uint8_t reply[TILE_REPLY_BYTES];
+
+    tile_frame_job(f, index, &job);
+    encode_tile_job(job_buf, &job);
+    if (!send_all(fd, job_buf, TILE_JOB_BYTES) || !wait_for_tile_reply(fd, f, index) ||
+        !recv_all(fd, reply, TILE_REPLY_BYTES)) {
+        return -1;
+    }
+
+    int count = job.tile_w * job.tile_h;
+    uint32_t encoding = get_u32(reply + 8);
+    uint32_t payload_len = get_u32(reply + 16);
+    if (get_u32(reply) != TILE_PROTO_MAGIC || get_u32(reply + 4) != job.job_id ||
+        get_u32(reply + 12) != (uint32_t)count || payload_len > (uint32_t)count * 4) {
+        fprintf(stderr, "Warning: malformed reply for tile %d\n", index);
+        return -1;
+    }
+    if (!recv_all(fd, payload, payload_len) ||
+        !decode_tile_payload(payload, payload_len, encoding, tile, count)) {
+        return -1;
+    }
+    return TILE_REPLY_BYTES + payload_len;
+}
+
+// Feed tiles to one worker connection until the frame is done or the worker
+// keeps failing, in which case it is skipped for WORKER_BACKOFF_MS
+void* remote_tile_thread(void* arg) {
+    remote_tile_args_t* args = (remote_tile_args_t*)arg;
+    tile_frame_t* f = args->frame;
+    remote_worker_t* w = args->worker;
+
+    uint16_t* tile = malloc(TILE_SIZE * TILE_SIZE * sizeof(uint16_t));
+    uint8_t* payload = malloc(TILE_SIZE * TILE_SIZE * 4);
+    int index;
+
+    while (get_time_ms() >= w->retry_after && tile && payload &&
+           (index = claim_tile(f, true)) >= 0) {
+        if (w->fd < 0) {
+            w->fd = connect_remote_worker(w);
+        }
+
+        long bytes = (w->fd >= 0) ? fetch_remote_tile(w->fd, f, index, tile, payload) : -1;
+        if (bytes >= 0) {
+            finish_tile(f, index, tile, true, bytes);
+            w->failures = 0;
+            continue;
+        }
+
+        // Tile lost or abandoned: hand it back and drop the connection, whose
+        // reply (if one ever comes) would now be out of step
+        finish_tile(f, index, NULL, false, 0);
+        if (w->fd >= 0) {
+            close(w->fd);
+            w->fd = -1;
+        }
+        if (frame_cancelled()) {
+            break;
+        }
+        if (++w->failures >= WORKER_MAX_RETRIES) {
+            fprintf(stderr, "Warning: worker %s:%s not responding, skipping for %d s\n",
+                    w->host, w->port, WORKER_BACKOFF_MS / 1000);
+            w->failures = 0;
+            w->retry_after = get_time_ms() + WORKER_BACKOFF_MS;
+            break;
+        }
+        if (!tile_done(f, index)) {
+            usleep(WORKER_RETRY_DELAY_MS * 1000);
+        }
+    }
+
+    free(tile);
+    free(payload);
+
+    pthread_mutex_lock(&f->mutex);
+    f->remote_active--;
+    pthread_cond_broadcast(&f->cond);
+    pthread_mutex_unlock(&f->mutex);
+    return NULL;
+}
+
+// Render tiles locally until none is left to claim. The calling (main)
+// thread only waits, so it keeps the input and presentation policy.
+void render_local_tiles(tile_frame_t* f) {
+    pthread_t local_threads[NUM_RENDER_THREADS];
+    bool local_started[NUM_RENDER_THREADS];
+    bool any_started = false;
+    for (int t = 0; t < NUM_RENDER_THREADS; t++) {
+        local_started[t] = pthread_create(&local_threads[t], NULL, local_tile_thread, f) == 0;
+        if (!local_started[t]) {
+            fprintf(stderr, "Error: Failed to create local tile thread %d\n", t);
+        }
+        any_started = any_started || local_started[t];
+    }
+    // Make progress even if no thread could be started
+    if (!any_started) {
+        render_claimed_tiles(f);
+    }
+    for (int t = 0; t < NUM_RENDER_THREADS; t++) {
+        if (local_started[t]) {
+            pthread_join(local_threads[t], NULL);
+        }
+    }
+}
+
+// Compute iteration counts for a whole frame in tiles, using the remote
+// workers when configured and local threads for whatever they leave behind.
+// Returns false if the frame was cancelled before every tile was done.
+bool render_iterations_tiled(uint16_t* iters, int frame_width, int frame_height,
+                             const saved_view_t* view) {
+    tile_frame_t f;
+    memset(&f, 0, sizeof(f));
+    f.iters = iters;
+    f.width = frame_width;
+    f.height = frame_height;
+    f.scaling = view->scaling;
+    f.x_offset = view->x_offset;
+    f.y_offset = view->y_offset;
+    f.formula = view->formula;
+    f.julia_re = view->julia_re;
+    f.julia_im = view->julia_im;
+    f.tiles_x = (frame_width + TILE_SIZE - 1) / TILE_SIZE;
+    f.num_tiles = f.tiles_x * ((frame_height + TILE_SIZE - 1) / TILE_SIZE);
+    f.tiles = calloc(f.num_tiles, sizeof(tile_status_t));
+    if (!f.tiles) {
+        fprintf(stderr, "Error: Could not allocate tile state\n");
+        return false;
+    }
+    pthread_mutex_init(&f.mutex, NULL);
+    pthread_cond_init(&f.cond, NULL);
+
+    if (num_remote_workers > 0) {
+        pthread_t remote_threads[MAX_REMOTE_WORKERS * WORKER_CONNECTIONS];
+        remote_tile_args_t remote_args[MAX_REMOTE_WORKERS * WORKER_CONNECTIONS];
+        bool started[MAX_REMOTE_WORKERS * WORKER_CONNECTIONS];
+
+        for (int t = 0; t < num_remote_workers; t++) {
+            remote_args[t].frame = &f;
+            remote_args[t].worker = &remote_workers[t];
+            f.remote_active++;
+            started[t] = pthread_create(&remote_threads[t], NULL, remote_tile_thread, &remote_args[t]) == 0;
+            if (!started[t]) {
+                f.remote_active--;
+                fprintf(stderr, "Error: Failed to create remote tile thread %d\n", t);
+            }
+        }
+
+        // Step in locally once the workers are gone, or when all tiles are
+        // handed out and one of them is straggling
+        pthread_mutex_lock(&f.mutex);
+        while (!frame_cancelled() && f.tiles_done < f.num_tiles) {
+            bool workers_gone = f.remote_active == 0;
+            int claimable = next_claimable_tile(&f);
+            bool straggling = claimable >= 0 && f.tiles[claimable].state == TILE_IN_FLIGHT;
+            if (workers_gone || straggling) {
+                pthread_mutex_unlock(&f.mutex);
+                render_local_tiles(&f);
+                pthread_mutex_lock(&f.mutex);
+                if (workers_gone) {
+                    break;
+                }
+                continue;
+            }
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += TILE_POLL_MS * 1000000L;
+            if (deadline.tv_nsec >= 1000000000) {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000;
+            }
+            pthread_cond_timedwait(&f.cond, &f.mutex, &deadline);
+        }
+        pthread_mutex_unlock(&f.mutex);
+
+        // Connections still awaiting replies give up within TILE_POLL_MS
+        for (int t = 0; t < num_remote_workers; t++) {
+            if (started[t]) {
+                pthread_join(remote_threads[t], NULL);
+            }
+        }
+    } else if (!frame_cancelled()) {
+        render_local_tiles(&f);
+    }
+
+    if (num_remote_workers > 0) {
+        long raw_bytes = (long)f.tiles_remote * TILE_SIZE * TILE_SIZE * sizeof(uint16_t);
+        printf("Tiles: %d/%d remote, %d re-dispatched, %ld KB received (~%ld KB raw)\n",
+               f.tiles_remote, f.num_tiles, f.tiles_redispatched,
+               f.bytes_received / 1024, raw_bytes / 1024);
+    }
+
+    bool complete = (f.tiles_done == f.num_tiles);
+    pthread_cond_destroy(&f.cond);
+    pthread_mutex_destroy(&f.mutex);
+    free(f.tiles);
+    return complete;
+}
+
+// Offline render: write a frame's iteration counts out as a binary PPM
+bool write_ppm(const char* filename, const uint16_t* iters, int frame_width, int frame_height,
+               int frame_colour_offset) {
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        fprintf(stderr, "Error opening %s: %s\n", filename, strerror(errno));
+        return false;
+    }
+
+    uint8_t palette[MAXI + 1][3];
+    uint8_t* rgb = malloc((size_t)frame_width * 3);
+    if (!rgb) {
+        fclose(file);
+        return false;
+    }
+    build_palette(palette, frame_colour_offset);
+
+    fprintf(file, "P6\n%d %d\n255\n", frame_width, frame_height);
+    for (int j = 0; j < frame_height; j++) {
+        const uint16_t* row = iters + (size_t)j * frame_width;
+        for (int i = 0; i < frame_width; i++) {
+            int n = row[i] > MAXI ? MAXI : row[i];
+            memcpy(rgb + i * 3, palette[n], 3);
+        }
+        fwrite(rgb, 3, frame_width, file);
+    }
+    free(rgb);
+
+    bool ok = !ferror(file);
+    if (fclose(file) != 0) {
+        ok = false;
+    }
+    return ok;
+}
+
+// Write one histogram in Prometheus text format (cumulative buckets, seconds)
+void write_histogram(FILE* out, const char* name, const char* help, histogram_t* h) {
+    uint64_t cumulative = 0;
+    fprintf(out, "# HELP %s %s\n# TYPE %s histogram\n", name, help, name);
+    for (int b = 0; b < HISTOGRAM_BUCKETS; b++) {
+        cumulative += STAT_LOAD(h->buckets[b]);
+        fprintf(out, "%s_bucket{le=\"%g\"} %llu\n", name, histogram_bounds_us[b] / 1e6,
+                (unsigned long long)cumulative);
+    }
+    cumulative += STAT_LOAD(h->buckets[HISTOGRAM_BUCKETS]);
+    fprintf(out, "%s_bucket{le=\"+Inf\"} %llu\n", name, (unsigned long long)cumulative);
+    fprintf(out, "%s_sum %.6f\n", name, STAT_LOAD(h->sum_us) / 1e6);
+    fprintf(out, "%s_count %llu\n", name, (unsigned long long)STAT_LOAD(h->count));
+}
+
+void write_counter(FILE* out, const char* name, const char* help, uint64_t value) {
+    fprintf(out, "# HELP %s %s\n# TYPE %s counter\n%s %llu\n",
+            name, help, name, name, (unsigned long long)value);
+}
+
+// Snapshot all render statistics in Prometheus text exposition format
+void write_metrics(FILE* out) {
+    write_histogram(out, "mandelbrot_frame_duration_seconds",
+                    "Time to render a completed frame, including anti-aliasing.", &stats.frame_time);
+    write_histogram(out, "mandelbrot_present_duration_seconds",
+                    "Time to write a frame assembled from worker tiles to the framebuffer.",
+                    &stats.present_time);
+    write_histogram(out, "mandelbrot_input_latency_seconds",
+                    "Time from a touch or button input to the completed frame showing it.",
+                    &stats.input_latency);
+    write_counter(out, "mandelbrot_frames_total", "Frames rendered to completion.",
+                  STAT_LOAD(stats.frames_rendered));
+    write_counter(out, "mandelbrot_frames_abandoned_total", "Frames cut short by newer input.",
+                  STAT_LOAD(stats.frames_abandoned));
+    write_counter(out, "mandelbrot_iterations_total", "Escape-time iterations computed.",
+                  STAT_LOAD(stats.iterations));
+    write_counter(out, "mandelbrot_pixels_total", "Pixels in completed frames.",
+                  STAT_LOAD(stats.pixels_rendered));
+    write_counter(out, "mandelbrot_pixels_short_circuited_total",
+                  "Pixels resolved without iterating (cardioid and bulb test).",
+                  STAT_LOAD(stats.pixels_short_circuited));
+    write_counter(out, "mandelbrot_antialias_pixels_refined_total", "Pixels supersampled by anti-aliasing.",
+                  STAT_LOAD(stats.aa_pixels_refined));
+    write_counter(out, "mandelbrot_framebuffer_bytes_written_total", "Bytes written to the framebuffer.",
+                  STAT_LOAD(stats.fb_bytes_written));
+
+    fprintf(out, "# HELP mandelbrot_render_thread_busy_seconds_total Time each render thread spent rendering.\n"
+                 "# TYPE mandelbrot_render_thread_busy_seconds_total counter\n");
+    for (int t = 0; t < NUM_RENDER_THREADS; t++) {
+        fprintf(out, "mandelbrot_render_thread_busy_seconds_total{thread=\"%d\"} %.6f\n",
+                t, STAT_LOAD(stats.thread_busy_us[t]) / 1e6);
+    }
+    fprintf(out, "# HELP mandelbrot_render_thread_idle_seconds_total Time each render thread waited on other bands.\n"
+                 "# TYPE mandelbrot_render_thread_idle_seconds_total counter\n");
+    for (int t = 0; t < NUM_RENDER_THREADS; t++) {
+        fprintf(out, "mandelbrot_render_thread_idle_seconds_total{thread=\"%d\"} %.6f\n",
+                t, STAT_LOAD(stats.thread_idle_us[t]) / 1e6);
+    }
+}
+
+// Metrics exporter thread: every connection to the Unix socket gets one
+// snapshot. Clients that send an HTTP request (curl --unix-socket, a
+// Prometheus sidecar) get an HTTP response; anything else (socat, nc -U)
+// just gets the text.
+void* metrics_handler(void* arg) {
+    const char* path = (const char*)arg;
+    struct sockaddr_un addr;
+
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "Warning: metrics socket path too long: %s\n", path);
+        return NULL;
+    }
+
+    // Replace a socket left by an earlier run, but never anything else
+    struct stat st;
+    if (lstat(path, &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            fprintf(stderr, "Warning: %s exists and is not a socket, metrics disabled\n", path);
+            return NULL;
+        }
+        unlink(path);
+    }
+
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0) {
+        fprintf(stderr, "Warning: Could not create metrics socket: %s\n", strerror(errno));
+        return NULL;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    if (bind(listen_fd, (struct sockaddr*)&addr, sizeof(addr)) < 0 || listen(listen_fd, 4) < 0) {
+        fprintf(stderr, "Warning: Could not listen on metrics socket %s: %s\n", path, strerror(errno));
+        close(listen_fd);
+        return NULL;
+    }
+
+    printf("Metrics available on %s\n", path);
+
+    struct pollfd pfd = { .fd = listen_fd, .events = POLLIN };
+    while (!quit_flag) {
+        if (poll(&pfd, 1, 200) <= 0) {
+            continue;
+        }
+        int fd = accept(listen_fd, NULL, NULL);
+        if (fd < 0) {
+            continue;
+        }
+
+        // Give an HTTP client a moment to send its request line
+        char request[512];
+        struct pollfd cfd = { .fd = fd, .events = POLLIN };
+        ssize_t n = 0;
+        if (poll(&cfd, 1, 100) > 0) {
+            n = recv(fd, request, sizeof(request) - 1, 0);
+        }
+        bool http = n >= 4 && strncmp(request, "GET ", 4) == 0;
+
+        char* text = NULL;
+        size_t text_len = 0;
+        FILE* out = open_memstream(&text, &text_len);
+        if (out) {
+            write_metrics(out);
+            fclose(out);
+            if (http) {
+                char header[128];
+                int header_len = snprintf(header, sizeof(header),
+                                          "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\n"
+                                          "Content-Length: %zu\r\n\r\n", text_len);
+                send_all(fd, header, header_len);
+            }
+            send_all(fd, text, text_len);
+            free(text);
+        }
+        close(fd);
+    }
+
+    close(listen_fd);
+    unlink(path);
+    return NULL;
+}
+
+// Structure to pass parameters and results to anti-aliasing threads
+typedef struct {
+    char* fbp;
+    char* pixels;           // RAM copy of the frame to refine as well, or NULL
+    struct fb_var_screeninfo* vinfo;
+    struct fb_fix_screeninfo* finfo;
+    const uint16_t* iters;
+    int start_row;
+    int end_row;
+    double scaling;
+    double x_offset;
+    double y_offset;
+    int colour_offset;
+    int formula;
+    double julia_re;
+    double julia_im;
+    bool completed;         // Result: false if the pass was abandoned
+    long pixels_refined;    // Result: pixels that were supersampled
+    long base_iterations;   // Result: iterations spent on the plain render, skipped pixels excluded
+    long extra_iterations;  // Result: iterations spent on extra samples
+} antialias_args_t;
+
+// Deterministic per-sample jitter in [0, 1) so a static view does not shimmer
+double aa_jitter(int i, int j, int k) {
+    uint32_t h = (uint32_t)i * 73856093u ^ (uint32_t)j * 19349663u ^ (uint32_t)k * 83492791u;
+    h ^= h >> 13;
+    h *= 0x5bd1e995u;
+    h ^= h >> 15;
+    return (h & 0xFFFF) / 65536.0;
+}
+
+// True if any 4-neighbour's iteration count differs by more than the threshold
+bool aa_needs_refine(const uint16_t* iters, int i, int j) {
+    int n = iters[j * width + i];
+    int neighbours[4] = {
+        (i > 0) ? iters[j * width + i - 1] : n,
+        (i < width - 1) ? iters[j * width + i + 1] : n,
+        (j > 0) ? iters[(j - 1) * width + i] : n,
+        (j < height - 1) ? iters[(j + 1) * width + i] : n,
+    };
+    for (int k = 0; k < 4; k++) {
+        if (abs(neighbours[k] - n) > antialias_threshold) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Anti-aliasing worker: supersample high-gradient pixels in assigned rows
+void* antialias_worker_thread(void* arg) {
+    antialias_args_t* args = (antialias_args_t*)arg;
+    iterate_point_fn iterate = formula_iterate[args->formula];
+    skip_point_fn skips = formula_skips[args->formula];
+
+    apply_render_thread_policy();
+
+    int j;
+    for (j = args->start_row; j < args->end_row && !frame_cancelled(); j++) {
+        for (int i = 0; i < width; i++) {
+            int base = args->iters[j * width + i];
+            if (base != MAXI ||
+                !skips(i * args->scaling - args->x_offset, j * args->scaling - args->y_offset)) {
+                args->base_iterations += base;
+            }
+            if (!aa_needs_refine(args->iters, i, j)) {
+                continue;
+            }
+
+            // One jittered sample per quadrant of the pixel, averaged in RGB
+            int r_sum = 0, g_sum = 0, b_sum = 0;
+            for (int k = 0; k < AA_SAMPLES; k++) {
+                double dx = ((k & 1) + 0.25 + 0.5 * aa_jitter(i, j, 2 * k)) / 2 - 0.5;
+                double dy = ((k >> 1) + 0.25 + 0.5 * aa_jitter(i, j, 2 * k + 1)) / 2 - 0.5;
+                double u = (i + dx) * args->scaling - args->x_offset;
+                double v = (j + dy) * args->scaling - args->y_offset;
+                int n = MAXI;
+                if (!skips(u, v)) {
+                    n = iterate(u, v, args->julia_re, args->julia_im, MAXI);
+                    args->extra_iterations += n;
+                }
+
+                uint8_t r, g, b;
+                iteration_colour(n, args->colour_offset, &r, &g, &b);
+                r_sum += r;
+                g_sum += g;
+                b_sum += b;
+            }
+            set_pixel_fb(args->fbp, args->vinfo, args->finfo, i, j,
+                         r_sum / AA_SAMPLES, g_sum / AA_SAMPLES, b_sum / AA_SAMPLES);
+            if (args->pixels) {
+                set_pixel_fb(args->pixels, args->vinfo, args->finfo, i, j,
+                             r_sum / AA_SAMPLES, g_sum / AA_SAMPLES, b_sum / AA_SAMPLES);
+            }
+            args->pixels_refined++;
+        }
+    }
+
+    args->completed = (j == args->end_row);
+    return NULL;
+}
+
+// Adaptive anti-aliasing pass over a rendered frame, driven by its iteration
+// buffer: only pixels on band edges are supersampled and redrawn. Returns
+// false if new input cut the pass short, leaving the frame part-refined.
+bool antialias_frame(char* fbp, char* pixels, struct fb_var_screeninfo* vinfo,
+                     struct fb_fix_screeninfo* finfo, const uint16_t* iters,
+                     const saved_view_t* view, long render_ms) {
+    pthread_t aa_threads[NUM_RENDER_THREADS];
+    antialias_args_t aa_args[NUM_RENDER_THREADS];
+    bool started[NUM_RENDER_THREADS];
+    int rows_per_thread = height / NUM_RENDER_THREADS;
+    long start_ms = get_time_ms();
+
+    for (int t = 0; t < NUM_RENDER_THREADS; t++) {
+        memset(&aa_args[t], 0, sizeof(aa_args[t]));
+        aa_args[t].fbp = fbp;
+        aa_args[t].pixels = pixels;
+        aa_args[t].vinfo = vinfo;
+        aa_args[t].finfo = finfo;
+        aa_args[t].iters = iters;
+        aa_args[t].start_row = t * rows_per_thread;
+        aa_args[t].end_row = (t == NUM_RENDER_THREADS - 1) ? height : (t + 1) * rows_per_thread;
+        aa_args[t].scaling = view->scaling;
+        aa_args[t].x_offset = view->x_offset;
+        aa_args[t].y_offset = view->y_offset;
+        aa_args[t].colour_offset = view->colour_offset;
+        aa_args[t].formula = view->formula;
+        aa_args[t].julia_re = view->julia_re;
+        aa_args[t].julia_im = view->julia_im;
+
+        started[t] = pthread_create(&aa_threads[t], NULL, antialias_worker_thread, &aa_args[t]) == 0;
+        if (!started[t]) {
+            fprintf(stderr, "Error: Failed to create anti-aliasing thread %d\n", t);
+        }
+    }
+
+    long refined = 0, base_iterations = 0, extra_iterations = 0;
+    bool completed = true;
+    for (int t = 0; t < NUM_RENDER_THREADS; t++) {
+        if (started[t]) {
+            pthread_join(aa_threads[t], NULL);
+            completed = completed && aa_args[t].completed;
+        }
+        refined += aa_args[t].pixels_refined;
+        base_iterations += aa_args[t].base_iterations;
+        extra_iterations += aa_args[t].extra_iterations;
+    }
+    long aa_ms = get_time_ms() - start_ms;
+
+    STAT_ADD(stats.iterations, (uint64_t)extra_iterations);
+    STAT_ADD(stats.aa_pixels_refined, (uint64_t)refined);
+    STAT_ADD(stats.fb_bytes_written, (uint64_t)refined * (vinfo->bits_per_pixel / 8));
+    if (!completed) {
+        return false;
+    }
+
+    // Cost relative to the plain render, by wall time and by iterations
+    // (uniform AA_SAMPLES-x supersampling would cost AA_SAMPLES on both)
+    printf("Anti-aliasing refined %.1f%% of pixels in %ld ms: cost %.2fx time, %.2fx iterations.\n",
+           100.0 * refined / ((long)width * height), aa_ms,
+           render_ms > 0 ? (double)(render_ms + aa_ms) / render_ms : 0.0,
+           base_iterations > 0 ? (double)(base_iterations + extra_iterations) / base_iterations : 0.0);
+    return true;
+}
+
+// Create the shared memory ring that completed frames are published into
+bool frame_export_open(const char* name, struct fb_var_screeninfo* vinfo,
+                       struct fb_fix_screeninfo* finfo) {
+    size_t align = FRAME_EXPORT_ALIGN;
+    size_t pixels_size = (size_t)height * finfo->line_length;
+    size_t iterations_offset = (sizeof(frame_export_slot_t) + pixels_size + 63) / 64 * 64;
+    size_t slot_size = (iterations_offset + (size_t)width * height * sizeof(uint16_t) + align - 1) / align * align;
+    size_t slots_offset = (sizeof(frame_export_header_t) + align - 1) / align * align;
+    size_t size = slots_offset + slot_size * FRAME_EXPORT_SLOTS;
+
+    int fd = shm_open(name, O_CREAT | O_RDWR, 0644);
+    if (fd < 0) {
+        fprintf(stderr, "Warning: Could not create frame export %s: %s\n", name, strerror(errno));
+        return false;
+    }
+    if (ftruncate(fd, size) != 0) {
+        fprintf(stderr, "Warning: Could not size frame export %s: %s\n", name, strerror(errno));
+        close(fd);
+        shm_unlink(name);
+        return false;
+    }
+    void* map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "Warning: Could not map frame export %s: %s\n", name, strerror(errno));
+        shm_unlink(name);
+        return false;
+    }
+
+    // Clear any ring left behind by an earlier run before describing the new one
+    memset(map, 0, size);
+    frame_export_header_t* header = map;
+    header->version = FRAME_EXPORT_VERSION;
+    header->slot_count = FRAME_EXPORT_SLOTS;
+    header->width = width;
+    header->height = height;
+    header->bits_per_pixel = vinfo->bits_per_pixel;
+    header->line_length = finfo->line_length;
+    header->red_offset = vinfo->red.offset;
+    header->red_length = vinfo->red.length;
+    header->green_offset = vinfo->green.offset;
+    header->green_length = vinfo->green.length;
+    header->blue_offset = vinfo->blue.offset;
+    header->blue_length = vinfo->blue.length;
+    header->max_iterations = MAXI;
+    header->slots_offset = slots_offset;
+    header->slot_size = slot_size;
+    header->pixels_offset = sizeof(frame_export_slot_t);
+    header->iterations_offset = iterations_offset;
+    __atomic_store_n(&header->magic, FRAME_EXPORT_MAGIC, __ATOMIC_RELEASE);
+
+    frame_export = header;
+    frame_export_size = size;
+    frame_export_name = name;
+    printf("Exporting frames to shared memory %s (%d slots, %zu bytes)\n",
+           name, FRAME_EXPORT_SLOTS, size);
+    return true;
+}
+
+// Copy a completed frame into the next ring slot. The pixels come from the
+// RAM copy, never the framebuffer mapping, which is slow or uncached to read
+// on SPI displays. Costs two frame-sized memcpys on the render thread;
+// readers never block it, they detect a slot being overwritten from its
+// sequence number and skip that frame.
+void frame_export_publish(const char* pixels, const uint16_t* iters,
+                          const saved_view_t* view, long render_ms) {
+    frame_export_header_t* header = frame_export;
+    uint64_t sequence = header->latest + 1;
+    char* base = (char*)header + header->slots_offset +
+                 ((sequence - 1) % header->slot_count) * header->slot_size;
+    frame_export_slot_t* slot = (frame_export_slot_t*)base;
+
+    // Invalidate the slot before its contents change
+    __atomic_store_n(&slot->sequence, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    slot->timestamp_us = get_time_us();
+    slot->render_ms = render_ms;
+    slot->formula = view->formula;
+    snprintf(slot->formula_name, sizeof(slot->formula_name), "%s", formula_names[view->formula]);
+    slot->colour_offset = view->colour_offset;
+    slot->scaling = view->scaling;
+    slot->x_offset = view->x_offset;
+    slot->y_offset = view->y_offset;
+    slot->julia_re = view->julia_re;
+    slot->julia_im = view->julia_im;
+    memcpy(base + header->pixels_offset, pixels, (size_t)height * header->line_length);
+    memcpy(base + header->iterations_offset, iters, (size_t)width * height * sizeof(uint16_t));
+
+    __atomic_store_n(&slot->sequence, sequence, __ATOMIC_RELEASE);
+    __atomic_store_n(&header->latest, sequence, __ATOMIC_RELEASE);
+}
+
+// Render the current fractal to framebuffer (multi-threaded)
+void render_mandelbrot(char* fbp, struct fb_var_screeninfo* vinfo,
+                       struct fb_fix_screeninfo* finfo) {
+    saved_view_t view;
+    struct timespec start_time, end_time;
+
+    // Claim the input this frame will show before reading the parameters.
+    // Input arriving from here on gets its own timestamp and latency sample.
+    int64_t input_us = __atomic_exchange_n(&input_pending_us, 0, __ATOMIC_RELAXED);
+
+    // Copy parameters with mutex protection; the formula is fixed for the frame
+    pthread_mutex_lock(&param_mutex);
+    view.scaling = scaling;
+    view.x_offset = x_offset;
+    view.y_offset = y_offset;
+    view.colour_offset = colour_offset;
+    view.formula = formula;
+    view.julia_re = julia_re;
+    view.julia_im = julia_im;
+    pthread_mutex_unlock(&param_mutex);
+
+    if (view.formula == FORMULA_JULIA) {
+        printf("Rendering julia set c=(%.6f, %.6f) (scaling=%.6f, x_off=%.6f, y_off=%.6f)...\n",
+               view.julia_re, view.julia_im, view.scaling, view.x_offset, view.y_offset);
+    } else {
+        printf("Rendering %s set (scaling=%.6f, x_off=%.6f, y_off=%.6f)...\n",
+               formula_names[view.formula], view.scaling, view.x_offset, view.y_offset);
+    }
+
+    // Start timing
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+    int64_t start_us = get_time_us();
+    bool completed = true;
+    uint64_t frame_iteration_count = 0;
+    uint64_t frame_short_circuited = 0;
+    long bytes_per_pixel = vinfo->bits_per_pixel / 8;
+    uint64_t frame_bytes = 0;
+
+    // When exporting, draw into the RAM copy and write it to the framebuffer
+    // in one pass, so the export never has to read the framebuffer back
+    char* draw = frame_pixels ? frame_pixels : fbp;
+
+    // Distributed rendering: workers return iteration tiles, colour them here
+    if (num_remote_workers > 0 && frame_iterations) {
+        completed = render_iterations_tiled(frame_iterations, width, height, &view);
+        if (completed) {
+            int64_t present_start_us = get_time_us();
+            skip_point_fn skips = formula_skips[view.formula];
+            uint8_t fb_palette[MAXI + 1][4];
+            build_fb_palette(fb_palette, vinfo, view.colour_offset);
+            for (int j = 0; j < height; j++) {
+                uint8_t* row = (uint8_t*)draw + (j + vinfo->yoffset) * finfo->line_length +
+                               vinfo->xoffset * bytes_per_pixel;
+                for (int i = 0; i < width; i++) {
+                    int n = frame_iterations[j * width + i];
+                    if (n > MAXI) {
+                        n = MAXI;
+                    }
+                    // Count as the band kernels do: skipped pixels cost no iterations
+                    if (n == MAXI && skips(i * view.scaling - view.x_offset, j * view.scaling - view.y_offset)) {
+                        frame_short_circuited++;
+                    } else {
+                        frame_iteration_count += n;
+                    }
+                    memcpy(row + i * bytes_per_pixel, fb_palette[n], bytes_per_pixel);
+                }
+            }
+            histogram_observe(&stats.present_time, get_time_us() - present_start_us);
+            frame_bytes = (uint64_t)width * height * bytes_per_pixel;
+        }
+    } else {
+        // Multi-threaded rendering: divide screen into horizontal bands
+        pthread_t render_threads[NUM_RENDER_THREADS];
+        render_worker_args_t worker_args[NUM_RENDER_THREADS];
+
+        // Calculate rows per thread
+        int rows_per_thread = height / NUM_RENDER_THREADS;
+
+        // Create worker threads
+        for (int t = 0; t < NUM_RENDER_THREADS; t++) {
+            memset(&worker_args[t], 0, sizeof(worker_args[t]));
+            worker_args[t].fbp = draw;
+            worker_args[t].vinfo = vinfo;
+            worker_args[t].finfo = finfo;
+            worker_args[t].start_row = t * rows_per_thread;
+            worker_args[t].end_row = (t == NUM_RENDER_THREADS - 1) ? height : (t + 1) * rows_per_thread;
+            worker_args[t].scaling = view.scaling;
+            worker_args[t].x_offset = view.x_offset;
+            worker_args[t].y_offset = view.y_offset;
+            worker_args[t].colour_offset = view.colour_offset;
+            worker_args[t].formula = view.formula;
+            worker_args[t].julia_re = view.julia_re;
+            worker_args[t].julia_im = view.julia_im;
+            worker_args[t].pixel_format = pixel_format_of(vinfo);
+            worker_args[t].iters = frame_iterations;
+
+            if (pthread_create(&render_threads[t], NULL, render_worker_thread, &worker_args[t]) != 0) {
+                fprintf(stderr, "Error: Failed to create render thread %d\n", t);
+            }
+        }
+
+        // Wait for all worker threads to complete
+        for (int t = 0; t < NUM_RENDER_THREADS; t++) {
+            pthread_join(render_threads[t], NULL);
+        }
+
+        // Per-thread busy/idle split: idle is time spent waiting on slower bands
+        int64_t wall_us = get_time_us() - start_us;
+        for (int t = 0; t < NUM_RENDER_THREADS; t++) {
+            completed = completed && worker_args[t].completed;
+            frame_iteration_count += worker_args[t].iterations;
+            frame_short_circuited += worker_args[t].short_circuited;
+            STAT_ADD(stats.thread_busy_us[t], (uint64_t)worker_args[t].busy_us);
+            if (wall_us > worker_args[t].busy_us) {
+                STAT_ADD(stats.thread_idle_us[t], (uint64_t)(wall_us - worker_args[t].busy_us));
+            }
+            frame_bytes += (uint64_t)worker_args[t].rows_rendered * width * bytes_per_pixel;
+        }
+    }
+
+    // Show whatever was drawn, abandoned or not, as direct drawing would have
+    if (frame_pixels) {
+        memcpy(fbp, frame_pixels, screensize);
+        frame_bytes = screensize;
+    }
+    STAT_ADD(stats.fb_bytes_written, frame_bytes);
+
+    // End timing and calculate elapsed time in milliseconds
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+    long elapsed_ms = (end_time.tv_sec - start_time.tv_sec) * 1000 +
+                      (end_time.tv_nsec - start_time.tv_nsec) / 1000000;
+
+    STAT_ADD(stats.iterations, frame_iteration_count);
+    STAT_ADD(stats.pixels_short_circuited, frame_short_circuited);
+
+    if (completed) {
+        if (num_remote_workers > 0 && frame_iterations) {
+            printf("Render complete in %ld ms (%d worker connections).\n", elapsed_ms, num_remote_workers);
+        } else {
+            printf("Render complete in %ld ms (4 threads).\n", elapsed_ms);
+        }
+
+        if (antialias_threshold >= 0 && frame_iterations) {
+            completed = !frame_cancelled() &&
+                        antialias_frame(fbp, frame_pixels, vinfo, finfo, frame_iterations, &view, elapsed_ms);
+        }
+    }
+
+    if (!completed) {
+        // New input arrived mid-frame; the main loop renders again at once.
+        // The claimed input is not on screen yet, so hand its timestamp back
+        // unless an even older one is already pending.
+        STAT_ADD(stats.frames_abandoned, 1);
+        printf("Render abandoned after %ld ms.\n", (long)((get_time_us() - start_us) / 1000));
+        int64_t pending = STAT_LOAD(input_pending_us);
+        while (input_us != 0 && (pending == 0 || pending > input_us) &&
+               !__atomic_compare_exchange_n(&input_pending_us, &pending, input_us, false,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        }
+        return;
+    }
+
+    if (frame_export && frame_pixels) {
+        frame_export_publish(frame_pixels, frame_iterations, &view, elapsed_ms);
+    }
+
+    int64_t done_us = get_time_us();
+    histogram_observe(&stats.frame_time, done_us - start_us);
+    STAT_ADD(stats.frames_rendered, 1);
+    STAT_ADD(stats.pixels_rendered, (uint64_t)width * height);
+
+    // Input claimed when the frame started is now on screen
+    if (input_us != 0) {
+        histogram_observe(&stats.input_latency, done_us - input_us);
+    }
+}
+
+// Load saved views from file
+void load_saved_views(const char* filename) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        printf("No saved views file found (%s), starting fresh.\n", filename);
+        return;
+    }
+
+    num_saved_views = 0;
+    char line[256];
+    char formula_name[32];
+    saved_view_t current_view = {0};
+    int fields_read = 0;
+
+    // formula/julia_* lines precede the four view fields; views saved before
+    // formulas existed have none and load as the Mandelbrot set
+    while (fgets(line, sizeof(line), file) && num_saved_views < MAX_SAVED_VIEWS) {
+        if (sscanf(line, "formula=%31s", formula_name) == 1) {
+            int f = formula_from_name(formula_name);
+            if (f < 0) {
+                fprintf(stderr, "Warning: unknown formula '%s' in %s\n", formula_name, filename);
+                f = FORMULA_MANDELBROT;
+            }
+            current_view.formula = f;
+        } else if (sscanf(line, "julia_re=%lf", &current_view.julia_re) == 1) {
+        } else if (sscanf(line, "julia_im=%lf", &current_view.julia_im) == 1) {
+        } else if (sscanf(line, "scaling=%lf", &current_view.scaling) == 1) {
+            fields_read++;
+        } else if (sscanf(line, "x_offset=%lf", &current_view.x_offset) == 1) {
+            fields_read++;
+        } else if (sscanf(line, "y_offset=%lf", &current_view.y_offset) == 1) {
+            fields_read++;
+        } else if (sscanf(line, "colour_offset=%d", &current_view.colour_offset) == 1) {
+            fields_read++;
+        }
+
+        // If we've read all 4 fields, save the view
+        if (fields_read == 4) {
+            saved_views[num_saved_views++] = current_view;
+            fields_read = 0;
+            memset(&current_view, 0, sizeof(current_view));
+        }
+    }
+
+    fclose(file);
+    printf("Loaded %d saved view(s) from %s\n", num_saved_views, filename);
+}
+
+// Offline render: frame a view (reset view, or saved view N) for the output
+// size, render it in tiles (remotely if workers are configured) and save a PPM
+int run_offline_render(const char* filename, int out_width, int out_height, int view_index) {
+    saved_view_t view = { scaling, x_offset, y_offset, colour_offset, formula, julia_re, julia_im };
+
+    if (view_index > 0) {
+        load_saved_views("saved_view.txt");
+        if (view_index > num_saved_views) {
+            fprintf(stderr, "Error: saved view %d not found (%d available)\n", view_index, num_saved_views);
+            return 1;
+        }
+        view = saved_views[view_index - 1];
+    }
+
+    // Keep the view's centre and horizontal extent as framed on the TFT
+    double centre_u = (REFERENCE_WIDTH / 2) * view.scaling - view.x_offset;
+    double centre_v = (REFERENCE_HEIGHT / 2) * view.scaling - view.y_offset;
+    double out_scaling = view.scaling * REFERENCE_WIDTH / out_width;
+    double out_x_offset = (out_width / 2) * out_scaling - centre_u;
+    double out_y_offset = (out_height / 2) * out_scaling - centre_v;
+    saved_view_t out_view = { out_scaling, out_x_offset, out_y_offset, view.colour_offset,
+                              view.formula, view.julia_re, view.julia_im };
+
+    uint16_t* iters = malloc((size_t)out_width * out_height * sizeof(uint16_t));
+    if (!iters) {
+        fprintf(stderr, "Error: Could not allocate %dx%d iteration buffer\n", out_width, out_height);
+        return 1;
+    }
+
+    printf("Rendering %dx%d offline to %s (scaling=%.10f)...\n", out_width, out_height, filename, out_scaling);
+    long start_ms = get_time_ms();
+    render_iterations_tiled(iters, out_width, out_height, &out_view);
+    long render_ms = get_time_ms() - start_ms;
+
+    bool ok = !quit_flag && write_ppm(filename, iters, out_width, out_height, view.colour_offset);
+    free(iters);
+    if (!ok) {
+        return 1;
+    }
+
+    // Throughput covers colouring and writing the file, not just the tiles
+    long elapsed_ms = get_time_ms() - start_ms;
+    printf("Offline render complete in %ld ms (render %ld ms, write %ld ms, %.2f Mpixel/s).\n",
+           elapsed_ms, render_ms, elapsed_ms - render_ms,
+           elapsed_ms > 0 ? (double)out_width * out_height / (elapsed_ms * 1000.0) : 0.0);
+    return 0;
+}
+
+void print_usage(const char* prog_name) {
+    printf("Usage: %s [options]\n", prog_name);
+    printf("Options:\n");
+    printf("  -d, --device <device>  Framebuffer device (default: /dev/fb1)\n");
+    printf("  -t, --touch <device>   Touch input device (default: /dev/input/event4)\n");
+    printf("  -f, --formula <name>   Fractal formula: mandelbrot, julia, multibrot3,\n");
+    printf("                         multibrot4, burningship (default: mandelbrot)\n");
+    printf("  -a, --antialias <n>    Supersample pixels whose neighbours differ by more than <n> iterations\n");
+    printf("  -m, --metrics <path>   Serve Prometheus-style metrics on a Unix socket\n");
+    printf("  -x, --export <name>    Publish completed frames to shared memory <name>, e.g. /mandelbrot\n");
+    printf("  -r, --render-cpus <l>  Pin render threads to CPU list <l>, e.g. 1-3 or 1,2,3\n");
+    printf("  -i, --input-cpu <n>    Reserve CPU <n> for input and presentation\n");
+    printf("  -F, --input-fifo <p>   Run input and presentation at SCHED_FIFO priority <p>\n");
+    printf("  -n, --render-nice <n>  Nice level for render threads (e.g. 10)\n");
+    printf("  -l, --low-power        Park instead of polling while no frame is pending\n");
+    printf("  -w, --worker <port>    Run as a tile worker listening on <port>\n");
+    printf("  -W, --workers <list>   Distribute rendering to host:port[,host:port...]\n");
+    printf("  -o, --output <file>    Render one frame offline to a PPM file and exit\n");
+    printf("  -s, --size <WxH>       Offline render size (default: 1920x1080)\n");
+    printf("  -v, --view <n>         Offline render saved view <n> (default: reset view)\n");
+    printf("  -h, --help             Show this help message\n");
+    printf("\nExamples:\n");
+    printf("  %s                     # Use TFT display (/dev/fb1)\n", prog_name);
+    printf("  %s -d /dev/fb0         # Use HDMI display\n", prog_name);
+    printf("  %s -t /dev/input/event0  # Use different touch device\n", prog_name);
+    printf("  %s -w 7878             # Serve tiles to a coordinator\n", prog_name);
+    printf("  %s -W pi2:7878,pi3:7878 -o deep.ppm -v 3  # Distributed offline render\n", prog_name);
+}
+
+int main(int argc, char* argv[]) {
+    int worker_port = 0;
+    const char* output_file = NULL;
+    int output_width = 1920;
+    int output_height = 1080;
+    int output_view = 0;
+    const char* metrics_socket = NULL;
+
+    // Parse command-line arguments
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else if (strcmp(argv[i], "-d") == 0 || strcmp(argv[i], "--device") == 0) {
+            if (i + 1 < argc) {
+                fb_device = argv[++i];
+            } else {
+                fprintf(stderr, "Error: -d/--device requires an argument\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--touch") == 0) {
+            if (i + 1 < argc) {
+                touch_device = argv[++i];
+            } else {
+                fprintf(stderr, "Error: -t/--touch requires an argument\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-f") == 0 || strcmp(argv[i], "--formula") == 0) {
+            if (i + 1 < argc && formula_from_name(argv[i + 1]) >= 0) {
+                initial_formula = formula_from_name(argv[++i]);
+                set_initial_view(initial_formula);
+            } else {
+                fprintf(stderr, "Error: -f/--formula requires a known formula name\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-a") == 0 || strcmp(argv[i], "--antialias") == 0) {
+            if (i + 1 < argc && argv[i + 1][0] >= '0' && argv[i + 1][0] <= '9') {
+                antialias_threshold = atoi(argv[++i]);
+            } else {
+                fprintf(stderr, "Error: -a/--antialias requires an iteration threshold\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-m") == 0 || strcmp(argv[i], "--metrics") == 0) {
+            if (i + 1 < argc) {
+                metrics_socket = argv[++i];
+            } else {
+                fprintf(stderr, "Error: -m/--metrics requires a socket path\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-x") == 0 || strcmp(argv[i], "--export") == 0) {
+            if (i + 1 < argc && argv[i + 1][0] == '/' && !strchr(argv[i + 1] + 1, '/')) {
+                frame_export_name = argv[++i];
+            } else {
+                fprintf(stderr, "Error: -x/--export requires a name like /mandelbrot\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--render-cpus") == 0) {
+            if (i + 1 < argc && parse_cpu_list(argv[i + 1], &render_cpu_set)) {
+                render_cpus_set = true;
+                i++;
+            } else {
+                fprintf(stderr, "Error: -r/--render-cpus requires a CPU list\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-i") == 0 || strcmp(argv[i], "--input-cpu") == 0) {
+            if (i + 1 < argc && sscanf(argv[i + 1], "%d", &input_cpu) == 1 &&
+                input_cpu >= 0 && input_cpu < CPU_SETSIZE) {
+                i++;
+            } else {
+                fprintf(stderr, "Error: -i/--input-cpu requires a CPU number\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-F") == 0 || strcmp(argv[i], "--input-fifo") == 0) {
+            if (i + 1 < argc && sscanf(argv[i + 1], "%d", &input_fifo_priority) == 1 &&
+                input_fifo_priority >= sched_get_priority_min(SCHED_FIFO) &&
+                input_fifo_priority <= sched_get_priority_max(SCHED_FIFO)) {
+                i++;
+            } else {
+                fprintf(stderr, "Error: -F/--input-fifo requires a priority from %d to %d\n",
+                        sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO));
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-n") == 0 || strcmp(argv[i], "--render-nice") == 0) {
+            if (i + 1 < argc && sscanf(argv[i + 1], "%d", &render_nice) == 1 &&
+                render_nice >= -20 && render_nice <= 19) {
+                i++;
+            } else {
+                fprintf(stderr, "Error: -n/--render-nice requires a nice level from -20 to 19\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-l") == 0 || strcmp(argv[i], "--low-power") == 0) {
+            low_power = true;
+        } else if (strcmp(argv[i], "-w") == 0 || strcmp(argv[i], "--worker") == 0) {
+            if (i + 1 < argc && atoi(argv[i + 1]) > 0 && atoi(argv[i + 1]) < 65536) {
+                worker_port = atoi(argv[++i]);
+            } else {
+                fprintf(stderr, "Error: -w/--worker requires a port number\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-W") == 0 || strcmp(argv[i], "--workers") == 0) {
+            if (i + 1 < argc) {
+                if (!parse_remote_workers(argv[++i])) {
+                    return 1;
+                }
+            } else {
+                fprintf(stderr, "Error: -W/--workers requires an argument\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "--output") == 0) {
+            if (i + 1 < argc) {
+                output_file = argv[++i];
+            } else {
+                fprintf(stderr, "Error: -o/--output requires an argument\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--size") == 0) {
+            if (i + 1 < argc && sscanf(argv[i + 1], "%dx%d", &output_width, &output_height) == 2 &&
+                output_width > 0 && output_height > 0 && output_width <= 32768 && output_height <= 32768) {
+                i++;
+            } else {
+                fprintf(stderr, "Error: -s/--size requires WIDTHxHEIGHT\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--view") == 0) {
+            if (i + 1 < argc && atoi(argv[i + 1]) > 0) {
+                output_view = atoi(argv[++i]);
+            } else {
+                fprintf(stderr, "Error: -v/--view requires a saved view number\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else {
+            fprintf(stderr, "Error: Unknown option '%s'\n", argv[i]);
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    // Set up signal handlers for Ctrl+C and systemctl stop, so cleanup() runs
+    signal(SIGINT, signal_handler);
+    signal(SIGTERM, signal_handler);
+
+    // Headless modes need neither the framebuffer nor the input devices
+    if (worker_port > 0) {
+        return run_tile_worker(worker_port);
+    }
+    if (output_file) {
+        return run_offline_render(output_file, output_width, output_height, output_view);
+    }
+
+    // Open framebuffer device
+    fb_fd = open(fb_device, O_RDWR);
+    if (fb_fd < 0) {
+        fprintf(stderr, "Error opening %s: ", fb_device);
+        perror("");
+        return 1;
+    }
+    
+    // Get fixed screen information
+    if (ioctl(fb_fd, FBIOGET_FSCREENINFO, &finfo) == -1) {
+        perror("Error reading fixed information");
+        close(fb_fd);
+        return 1;
+    }
+    
+    // Get variable screen information
+    if (ioctl(fb_fd, FBIOGET_VSCREENINFO, &vinfo) == -1) {
+        perror("Error reading variable information");
+        close(fb_fd);
+        return 1;
+    }
+    
+    // Set runtime dimensions from framebuffer
+    width = vinfo.xres;
+    height = vinfo.yres;
+
+    printf("Framebuffer device: %s\n", fb_device);
+    printf("  Display: %s\n", finfo.id);
+    printf("  Resolution: %dx%d\n", width, height);
     printf("  Bits per pixel: %d\n", vinfo.bits_per_pixel);
     printf("  Line length: %d bytes\n", finfo.line_length);
 
@@ -685,6 +2752,23 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    // Iteration buffer for frames assembled from worker tiles, anti-aliasing and export
+    if (num_remote_workers > 0 || antialias_threshold >= 0 || frame_export_name) {
+        frame_iterations = malloc((size_t)width * height * sizeof(uint16_t));
+        if (!frame_iterations) {
+            fprintf(stderr, "Warning: Could not allocate iteration buffer, "
+                            "rendering locally without anti-aliasing or export\n");
+        }
+    }
+
+    if (frame_export_name && frame_iterations &&
+        frame_export_open(frame_export_name, &vinfo, &finfo)) {
+        frame_pixels = calloc(1, screensize);
+        if (!frame_pixels) {
+            fprintf(stderr, "Warning: Could not allocate frame copy, frame export disabled\n");
+        }
+    }
+
     // Load saved views from file
     load_saved_views("saved_view.txt");
 
@@ -700,6 +2784,19 @@ int main(int argc, char* argv[]) {
     // Initialize idle timer
     reset_idle_timer();
 
+    // Start metrics exporter thread (before the input policy, so it does not inherit it)
+    pthread_t metrics_thread;
+    bool metrics_started = false;
+    if (metrics_socket) {
+        metrics_started = pthread_create(&metrics_thread, NULL, metrics_handler, (void*)metrics_socket) == 0;
+        if (!metrics_started) {
+            fprintf(stderr, "Warning: Failed to create metrics thread\n");
+        }
+    }
+
+    // Input and presentation policy is inherited by the input threads
+    apply_input_thread_policy();
+
     // Start touch handler thread
     pthread_t touch_thread;
     if (pthread_create(&touch_thread, NULL, touch_handler, NULL) != 0) {
@@ -742,10 +2839,14 @@ int main(int argc, char* argv[]) {
             if (delta_scaling < SNAP_DELTA_SCALING &&
                 delta_x < SNAP_DELTA_OFFSET &&
                 delta_y < SNAP_DELTA_OFFSET) {
-                // Snap position/zoom to target
+                // Snap position/zoom to target. Formulas cannot be
+                // interpolated, so the target's takes over here too
                 scaling = target->scaling;
                 x_offset = target->x_offset;
                 y_offset = target->y_offset;
+                formula = target->formula;
+                julia_re = target->julia_re;
+                julia_im = target->julia_im;
 
                 // Cycle colour one step toward target
                 if (colour_offset != target->colour_offset) {
@@ -782,7 +2883,12 @@ int main(int argc, char* argv[]) {
             render_mandelbrot(fbp, &vinfo, &finfo);
         }
 
-        usleep(ANIMATION_STEP_MS * 1000); // Sleep between animation frames
+        if (low_power && !animating) {
+            // Park until input arrives or the idle animation is due
+            wait_for_redraw(num_saved_views > 0 ? last_interaction_time + IDLE_TIMEOUT_MS : 0);
+        } else {
+            usleep(ANIMATION_STEP_MS * 1000); // Sleep between animation frames
+        }
     }
 
     printf("\nExiting...\n");
@@ -790,6 +2896,9 @@ int main(int argc, char* argv[]) {
     // Wait for threads to finish
     pthread_join(touch_thread, NULL);
     pthread_join(button_thread, NULL);
+    if (metrics_started) {
+        pthread_join(metrics_thread, NULL);
+    }
 
     // Cleanup
     cleanup();